@@ -0,0 +1,248 @@
+// Headless benchmark of ImGui::Plot(). There is no renderer: every frame
+// runs NewFrame(), a window with one Plot() and Render(), the font atlas is
+// built on the CPU. Prints one line per case of the input matrix.
+//
+//  imgui_plot_bench [--frames N] [--max-samples N] [--count N] [--series N]
+//                   [--type NAME] [--decimation none|minmax|lttb]
+//
+// --count, --series and --type restrict the matrix to one value, cases with
+// more than --max-samples samples over all series are skipped.
+
+#include <imgui_plot.h>
+#include <imgui.h>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <vector>
+
+typedef ImGui::PlotConfig::Buffer::Type BufferType;
+typedef ImGui::PlotConfig::Scale::Type ScaleType;
+
+struct BenchCase {
+    size_t count;
+    size_t series;
+    BufferType type;
+    ScaleType scale;
+    bool xs;
+    bool decorations; // axis labels, grid, tooltip and selection
+};
+
+struct BenchResult {
+    double ns_per_frame;
+    double samples_per_second;
+    int vtx;
+    int idx;
+};
+
+static const BufferType buffer_types[] = {
+    BufferType::float32, BufferType::float64, BufferType::int32, BufferType::int16,
+    BufferType::uint16, BufferType::uint8, BufferType::int64, BufferType::uint32,
+};
+
+static const char* type_name(BufferType type) {
+    switch (type) {
+    case BufferType::float32: return "float32";
+    case BufferType::float64: return "float64";
+    case BufferType::int32: return "int32";
+    case BufferType::int16: return "int16";
+    case BufferType::uint16: return "uint16";
+    case BufferType::uint8: return "uint8";
+    case BufferType::int64: return "int64";
+    case BufferType::uint32: return "uint32";
+    }
+    return "?";
+}
+
+static size_t type_size(BufferType type) {
+    switch (type) {
+    case BufferType::float32: return sizeof(float);
+    case BufferType::float64: return sizeof(double);
+    case BufferType::int32: return sizeof(int32_t);
+    case BufferType::int16: return sizeof(int16_t);
+    case BufferType::uint16: return sizeof(uint16_t);
+    case BufferType::uint8: return sizeof(uint8_t);
+    case BufferType::int64: return sizeof(int64_t);
+    case BufferType::uint32: return sizeof(uint32_t);
+    }
+    return 0;
+}
+
+// Positive values within [10, 190], so they fit every type and Log10 axes
+template<typename T> static void fill(unsigned char* data, size_t count, size_t series) {
+    T* out = reinterpret_cast<T*>(data);
+    for (size_t s = 0; s < series; s++) {
+        const float freq = 1e-3f * (s + 1);
+        for (size_t i = 0; i < count; i++) {
+            out[s * count + i] = static_cast<T>(100.0f + 90.0f * sinf(i * freq));
+        }
+    }
+}
+
+static void fill(BufferType type, unsigned char* data, size_t count, size_t series) {
+    switch (type) {
+    case BufferType::float32: fill<float>(data, count, series); break;
+    case BufferType::float64: fill<double>(data, count, series); break;
+    case BufferType::int32: fill<int32_t>(data, count, series); break;
+    case BufferType::int16: fill<int16_t>(data, count, series); break;
+    case BufferType::uint16: fill<uint16_t>(data, count, series); break;
+    case BufferType::uint8: fill<uint8_t>(data, count, series); break;
+    case BufferType::int64: fill<int64_t>(data, count, series); break;
+    case BufferType::uint32: fill<uint32_t>(data, count, series); break;
+    }
+}
+
+static BenchResult run_case(const BenchCase& c, int max_frames, ImGui::PlotConfig::Decimation decimation) {
+    const size_t size = type_size(c.type);
+    std::vector<unsigned char> data(c.count * c.series * size);
+    fill(c.type, data.data(), c.count, c.series);
+    std::vector<float> xs;
+    if (c.xs) {
+        xs.resize(c.count);
+        for (size_t i = 0; i < c.count; i++) xs[i] = static_cast<float>(i + 1);
+    }
+    std::vector<ImGui::PlotConfig::Buffer> ys(c.series);
+    for (size_t s = 0; s < c.series; s++) {
+        ys[s] = ImGui::PlotConfig::Buffer(data.data() + s * c.count * size, c.type, 0, 0);
+    }
+
+    // indices start at 0, which a Log10 x-axis can't show
+    static float view_min, view_max;
+    view_min = 1.0f;
+    view_max = static_cast<float>(c.count - 1);
+
+    static size_t selection_start, selection_length;
+    selection_start = c.count / 4;
+    selection_length = c.count / 2;
+
+    ImGui::PlotConfig conf;
+    if (c.xs) conf.values.xs = xs.data();
+    conf.values.ys_list = ys.data();
+    conf.values.ys_count = c.series;
+    conf.values.count = c.count;
+    conf.scale.min = c.scale == ScaleType::Log10 ? 1.0f : 0.0f;
+    conf.scale.max = c.scale == ScaleType::Log10 ? 1000.0f : 200.0f;
+    conf.scale.type = c.scale;
+    conf.scale.type_y = c.scale;
+    if (c.scale == ScaleType::Log10 && !c.xs) {
+        conf.view.x_min = &view_min;
+        conf.view.x_max = &view_max;
+    }
+    conf.frame_size = ImVec2(-1, -1);
+    conf.decimation = decimation;
+    conf.tooltip.show = c.decorations;
+    conf.axis_x.grid_show = conf.axis_y.grid_show = c.decorations;
+    conf.axis_x.label_show_bl = conf.axis_y.label_show_bl = c.decorations;
+    conf.axis_x.tick_distance = c.count / 10.0f;
+    conf.axis_y.tick_distance = 50.0f;
+    conf.selection.show = c.decorations;
+    conf.selection.start = &selection_start;
+    conf.selection.length = &selection_length;
+
+    ImGuiIO& io = ImGui::GetIO();
+    int vtx = 0, idx = 0;
+    auto frame = [&]() {
+        ImGui::NewFrame();
+        ImGui::SetNextWindowPos(ImVec2(0, 0));
+        ImGui::SetNextWindowSize(io.DisplaySize);
+        ImGui::Begin("bench", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoSavedSettings);
+        ImDrawList* draw_list = ImGui::GetWindowDrawList();
+        const int vtx_start = draw_list->VtxBuffer.Size;
+        const int idx_start = draw_list->IdxBuffer.Size;
+        ImGui::Plot("plot", conf);
+        vtx = draw_list->VtxBuffer.Size - vtx_start;
+        idx = draw_list->IdxBuffer.Size - idx_start;
+        ImGui::End();
+        ImGui::Render();
+    };
+
+    // the first frame lays out the window and fills the caches
+    ImGui::PlotInvalidateCache();
+    frame();
+
+    typedef std::chrono::steady_clock Clock;
+    const Clock::time_point start = Clock::now();
+    int frames = 0;
+    double elapsed = 0;
+    // at least 3 frames, then stop after a second
+    while (frames < max_frames && (frames < 3 || elapsed < 1.0)) {
+        frame();
+        frames++;
+        elapsed = std::chrono::duration<double>(Clock::now() - start).count();
+    }
+
+    BenchResult r;
+    r.ns_per_frame = elapsed * 1e9 / frames;
+    r.samples_per_second = static_cast<double>(c.count * c.series) * frames / elapsed;
+    r.vtx = vtx;
+    r.idx = idx;
+    return r;
+}
+
+int main(int argc, char** argv) {
+    int max_frames = 20;
+    double max_samples = 1e8;
+    size_t only_count = 0, only_series = 0;
+    const char* only_type = nullptr;
+    ImGui::PlotConfig::Decimation decimation = ImGui::PlotConfig::Decimation::None;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (!strcmp(argv[i], "--frames")) max_frames = atoi(argv[i + 1]);
+        else if (!strcmp(argv[i], "--max-samples")) max_samples = atof(argv[i + 1]);
+        else if (!strcmp(argv[i], "--count")) only_count = static_cast<size_t>(atof(argv[i + 1]));
+        else if (!strcmp(argv[i], "--series")) only_series = static_cast<size_t>(atof(argv[i + 1]));
+        else if (!strcmp(argv[i], "--type")) only_type = argv[i + 1];
+        else if (!strcmp(argv[i], "--decimation")) {
+            if (!strcmp(argv[i + 1], "minmax")) decimation = ImGui::PlotConfig::Decimation::MinMax;
+            else if (!strcmp(argv[i + 1], "lttb")) decimation = ImGui::PlotConfig::Decimation::LTTB;
+        }
+        else {
+            fprintf(stderr, "unknown option %s\n", argv[i]);
+            return 1;
+        }
+    }
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.DisplaySize = ImVec2(1280, 720);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.IniFilename = nullptr;
+    // hovering the plot center shows the tooltip and hover markers
+    io.MousePos = ImVec2(640, 360);
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+
+    static const size_t counts[] = { 1000, 10000, 100000, 1000000, 10000000, 100000000 };
+    static const size_t series_counts[] = { 1, 16, 256 };
+    static const ScaleType scales[] = { ScaleType::Linear, ScaleType::Log10 };
+
+    printf("%10s %6s %8s %6s %3s %5s %14s %12s %9s %9s\n",
+        "samples", "series", "type", "scale", "xs", "decor", "ns/frame", "Msamples/s", "vtx", "idx");
+    for (size_t count : counts) {
+        if (only_count && count != only_count) continue;
+        for (size_t series : series_counts) {
+            if (only_series && series != only_series) continue;
+            if (static_cast<double>(count) * series > max_samples) continue;
+            for (BufferType type : buffer_types) {
+                if (only_type && strcmp(only_type, type_name(type))) continue;
+                for (ScaleType scale : scales) {
+                    for (int xs = 0; xs < 2; xs++) {
+                        for (int decorations = 0; decorations < 2; decorations++) {
+                            const BenchCase c = { count, series, type, scale, xs != 0, decorations != 0 };
+                            const BenchResult r = run_case(c, max_frames, decimation);
+                            printf("%10zu %6zu %8s %6s %3s %5s %14.0f %12.1f %9d %9d\n",
+                                count, series, type_name(type), scale == ScaleType::Log10 ? "log10" : "linear",
+                                xs ? "yes" : "no", decorations ? "yes" : "no",
+                                r.ns_per_frame, r.samples_per_second / 1e6, r.vtx, r.idx);
+                            fflush(stdout);
+                        }
+                    }
+                }
+            }
+        }
+    }
+
+    ImGui::DestroyContext();
+    return 0;
+}
@@ -3,6 +3,22 @@
 #include <imgui.h>
 
 namespace ImGui {
+// What one Plot() call did and how long it took. Times are in seconds.
+struct PlotStats {
+    size_t samples_visited = 0;  // including the ones read for Scale::auto_fit and LOD updates
+    size_t segments_emitted = 0; // line segments added to the draw list
+    size_t segments_skipped = 0; // dropped by skip_small_lines
+    size_t segments_clipped = 0; // segments or markers outside of the plot rect
+    size_t markers_emitted = 0;
+    size_t markers_merged = 0;   // on a pixel that already had a marker of the series
+    int vertices = 0;            // added to the window draw list
+    int indices = 0;
+    double time_axes = 0;        // frame, axis range, grid, labels and v_lines
+    double time_series = 0;      // decimation, transform and drawing of the series
+    double time_interaction = 0; // zoom, pan, tooltip and selection
+    double time_total = 0;
+};
+
 // Use this structure to pass the plot data and settings into the Plot function
 struct PlotConfig {
     // Helper struct to avoid templating overhead
@@ -10,19 +26,41 @@ struct PlotConfig {
         enum class Type {
             float32,
             float64,
-            int32
+            int32,
+            int16,
+            uint16,
+            uint8,
+            int64,
+            uint32
         } type = Type::float32;
         union {
             const void* raw = nullptr;
             const float* float32;
             const double* float64;
             const int32_t* int32;
+            const int16_t* int16;
+            const uint16_t* uint16;
+            const uint8_t* uint8;
+            const int64_t* int64;
+            const uint32_t* uint32;
         };
+        // Byte offset of the first element from the pointer above
+        size_t offset = 0;
+        // Byte distance between two elements, 0 if they are tightly packed
+        size_t stride = 0;
 
         Buffer() : type(Type::float32), raw(nullptr) {}
         Buffer(const float* data) : type(Type::float32), float32(data) {}
         Buffer(const double* data) : type(Type::float64), float64(data) {}
         Buffer(const int32_t* data) : type(Type::int32), int32(data) {}
+        Buffer(const int16_t* data) : type(Type::int16), int16(data) {}
+        Buffer(const uint16_t* data) : type(Type::uint16), uint16(data) {}
+        Buffer(const uint8_t* data) : type(Type::uint8), uint8(data) {}
+        Buffer(const int64_t* data) : type(Type::int64), int64(data) {}
+        Buffer(const uint32_t* data) : type(Type::uint32), uint32(data) {}
+        // For data embedded in arrays of structs, e.g.
+        // Buffer(records, Type::float32, offsetof(Record, a), sizeof(Record))
+        Buffer(const void* data, Type _type, size_t _offset, size_t _stride) : type(_type), raw(data), offset(_offset), stride(_stride) {}
         const float operator[] (size_t) const;
         inline bool IsNullptr() const { return raw == nullptr; }
     };
@@ -42,6 +80,12 @@ struct PlotConfig {
         size_t ys_count = 0;
         // colors for each plot
         const ImU32* colors = nullptr;
+
+        // Ring buffer mode for scrolling plots. If capacity is not 0, every
+        // buffer above holds capacity elements and sample i (i < count) is
+        // stored at index (head + i) % capacity, i.e. head is the oldest one.
+        size_t capacity = 0;
+        size_t head = 0;
     } values;
     struct Scale {
         // Minimum plot value
@@ -54,6 +98,15 @@ struct PlotConfig {
         };
         // How to scale the x-axis
         Type type = Type::Linear;
+        // How to scale the y-axis. min and max must be positive for Log10.
+        Type type_y = Type::Linear;
+        // Fit min and max to the visible samples of all series every frame
+        bool auto_fit = false;
+        // Space left above and below the samples, as a fraction of their range
+        float auto_fit_padding = 0.05f;
+        // Round the fitted range outwards to multiples of 1, 2 or 5 times a
+        // power of ten (to powers of ten for Log10)
+        bool auto_fit_nice = true;
     } scale;
     struct Tooltip {
         bool show = false;
@@ -76,6 +129,19 @@ struct PlotConfig {
         // of power of two
         size_t(*sanitize_fn)(size_t) = nullptr;
     } selection;
+    struct View {
+        // Visible x range. Both must be set, if they are equal the whole
+        // data range is shown. Only the samples in view are processed.
+        float* x_min = nullptr;
+        float* x_max = nullptr;
+        // Zoom with the mouse wheel, pan by dragging with the right mouse
+        // button and reset by double clicking it. Writes x_min and x_max.
+        bool zoom_pan = false;
+    } view;
+    // Opt-in geometry cache. Change this value whenever the samples change;
+    // while it and the plot settings and layout stay the same, the series
+    // geometry of the previous frame is reused. 0 disables the cache.
+    uint64_t generation = 0;
     struct VerticalLines {
         bool show = false;
         Buffer xs; // at which x values to draw the lines
@@ -86,13 +152,107 @@ struct PlotConfig {
     float line_thickness = 1.f;
     // Can cause aliasing effects if enabled.
     bool skip_small_lines = true;
+    struct Markers {
+        enum class Shape {
+            None,
+            Circle,
+            Square,
+            Cross,
+            Triangle,
+        };
+        // Draw a marker at every sample instead of lines, e.g. for scatter
+        // plots. A pixel gets at most one marker of each series.
+        Shape shape = Shape::None;
+        // Width in pixels
+        float size = 4.0f;
+        // Connect the samples with lines as well
+        bool lines = false;
+    } markers;
+    enum class Decimation {
+        None,   // draw every sample
+        MinMax, // min/max envelope of each pixel column, keeps peaks visible
+        LTTB,   // largest triangle three buckets, one point per pixel column
+    };
+    // Reduce series with more samples than pixel columns before drawing them.
+    // skip_small_lines is ignored for decimated series.
+    Decimation decimation = Decimation::None;
+    // Samples are only ever appended and never modified, so caches only
+    // need to process the new ones when count grows: the LOD pyramid and
+    // the fitted y range refresh their tail, and series without decimation
+    // keep the screen positions of earlier samples for as long as the axis
+    // ranges and the plot rect stay the same. Without xs the x range grows
+    // with count, so the positions only carry over with a fixed view
+    // (View::x_min/x_max) and a fixed y range. Not used in ring buffer mode.
+    bool append_only = false;
+    struct LevelOfDetail {
+        // Keep a min/max pyramid of every series between frames, so that
+        // Decimation::MinMax and Scale::auto_fit don't have to visit every
+        // sample. The cache is rebuilt when a buffer, count or generation
+        // changes; modifying samples in place without a new generation
+        // requires PlotInvalidateCache(). Not used in ring buffer mode.
+        bool cache = false;
+        // Upper bound of the pyramid memory of one plot, in bytes. Large
+        // series get coarser pyramids to stay within it.
+        size_t memory_budget = 64 * 1024 * 1024;
+        // Optional precomputed minimum (x) and maximum (y) of every
+        // summary_bucket samples, one array per series in ys/ys_list order,
+        // e.g. from PlotFile. Pyramids are then built from these instead of
+        // the samples, but never finer than summary_bucket.
+        const ImVec2* const* summaries = nullptr;
+        size_t summary_bucket = 0; // must be set with summaries
+        // Rebuild pyramids in the background so that Plot() never waits for
+        // them: submit must arrange for job(job_data) to be called once on
+        // another thread and return right away. Until a pyramid is ready, the
+        // previous one is drawn if it covers the view, otherwise a coarse
+        // sampling of the series. A build is cancelled as soon as it is out
+        // of date. Buffers must stay valid while PlotLodBuilding() is true.
+        void (*submit)(void (*job)(void* job_data), void* job_data, void* user_data) = nullptr;
+        void* user_data = nullptr;
+    } lod;
+    struct Parallel {
+        // Builds the lines of several series concurrently: run must call
+        // task(i, task_data) once for every i in [0, count), on any threads,
+        // and return when all calls are done. The tasks only decimate and
+        // transform samples into per-series buffers, the draw list is still
+        // written on the calling thread in series order. The tasks don't
+        // call into ImGui or its allocator. Null builds the series one after
+        // another.
+        void (*run)(void (*task)(size_t i, void* task_data), size_t count, void* task_data, void* user_data) = nullptr;
+        void* user_data = nullptr;
+    } parallel;
     const char* overlay_text = nullptr;
+    // Filled in by every Plot() call if not null. Defining
+    // IMGUI_PLOT_DISABLE_STATS compiles the measurements out.
+    PlotStats* stats = nullptr;
 };
 
 enum class PlotStatus {
     nothing,
     selection_updated,
+    view_updated,
 };
 
 IMGUI_API PlotStatus Plot(const char* label, const PlotConfig& conf);
+
+// Frees everything cached between frames for the plot with the given id
+// (GetID(label) in the plot's window), or for all plots if id is 0. Plots
+// that aren't drawn for a few hundred frames and the plots of a destroyed
+// context are freed without it.
+IMGUI_API void PlotInvalidateCache(ImGuiID id = 0);
+
+// Fraction of the pending LevelOfDetail::submit builds of a plot that is
+// done, 1 if there are none
+IMGUI_API float PlotLodProgress(ImGuiID id);
+
+// Whether any LevelOfDetail::submit job is still running, including
+// cancelled ones that have not returned yet
+IMGUI_API bool PlotLodBuilding();
+
+// Stats of the last measured Plot() call of a plot, false if there are none.
+// Plots are measured if PlotConfig::stats is set or the stats window is shown.
+// Always false with IMGUI_PLOT_DISABLE_STATS.
+IMGUI_API bool PlotGetStats(ImGuiID id, PlotStats* out);
+
+// Lists the plots of the last frame, the slowest ones first
+IMGUI_API void ShowPlotStatsWindow(bool* p_open = nullptr);
 }
@@ -0,0 +1,68 @@
+#pragma once
+#include <imgui_plot.h>
+
+namespace ImGui {
+// Read-only capture file of raw interleaved samples, mapped into memory so
+// that captures larger than RAM can be plotted. Only the pages a plot reads
+// are loaded. A min/max summary is kept next to the file in
+// "<path>.minmax"; it is built on the first open and reused as long as the
+// file doesn't change. Hand it to the plot so the level-of-detail pyramid
+// doesn't have to read the whole capture:
+//
+//  PlotFile file;
+//  file.Open("capture.raw", PlotConfig::Buffer::Type::int16, 64, 2);
+//  PlotConfig::Buffer ys[] = { file.Channel(0), file.Channel(1) };
+//  const ImVec2* summaries[] = { file.Summary(0), file.Summary(1) };
+//  conf.values.ys_list = ys;
+//  conf.values.ys_count = 2;
+//  conf.values.count = file.Count();
+//  conf.decimation = PlotConfig::Decimation::MinMax;
+//  conf.lod.cache = true;
+//  conf.lod.summaries = summaries;
+//  conf.lod.summary_bucket = PlotFile::summary_bucket;
+struct PlotFile {
+    // Samples per summary entry
+    static const size_t summary_bucket = 512;
+
+    PlotFile() {}
+    ~PlotFile() { Close(); }
+
+    // header is the number of bytes before the first sample, a multiple of
+    // the sample type's size, and channels the number of interleaved series.
+    // Returns false if the file can't be mapped, the header is misaligned or
+    // the file doesn't hold a single complete sample.
+    bool Open(const char* path, PlotConfig::Buffer::Type type, size_t header = 0, size_t channels = 1);
+    void Close();
+
+    bool IsOpen() const { return file.data != nullptr; }
+    // Samples per channel
+    size_t Count() const { return count; }
+    size_t Channels() const { return channels; }
+    // Samples of one channel, an empty buffer if no file is open
+    PlotConfig::Buffer Channel(size_t channel) const;
+    // Minimum (x) and maximum (y) of every summary_bucket samples of a
+    // channel, the last entry covers the remaining samples
+    const ImVec2* Summary(size_t channel) const;
+
+private:
+    struct Mapping {
+        const unsigned char* data = nullptr;
+        size_t size = 0;
+    };
+
+    PlotFile(const PlotFile&);
+    PlotFile& operator=(const PlotFile&);
+
+    bool LoadSummary(const char* path, uint64_t file_time);
+    void BuildSummary(const char* path, uint64_t file_time);
+
+    Mapping file;
+    Mapping sidecar;
+    ImVector<ImVec2> summary_built; // used if the sidecar couldn't be written
+    const ImVec2* summary = nullptr;
+    PlotConfig::Buffer::Type type = PlotConfig::Buffer::Type::float32;
+    size_t header = 0;
+    size_t channels = 0;
+    size_t count = 0;
+};
+}
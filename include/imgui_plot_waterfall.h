@@ -0,0 +1,88 @@
+#pragma once
+#include <imgui_plot.h>
+
+namespace ImGui {
+// Scrolling spectrogram. Every PushRow() adds one spectrum at the top and
+// moves the older ones down. Values become colors through a lookup table,
+// and only the new rows are converted and uploaded to the texture. The
+// image is drawn as one textured quad:
+//
+//  static PlotWaterfall waterfall;
+//  if (waterfall.Width() == 0) {
+//      waterfall.Init(fft_size / 2, 256);
+//      waterfall.SetRange(-120.0f, 0.0f);
+//      waterfall.SetColormap(PlotWaterfall::Colormap::Magma);
+//      waterfall.update_texture = upload;
+//  }
+//  waterfall.PushRow(spectrum_db);
+//  waterfall.Draw("waterfall", ImVec2(-1, 300));
+//
+// Pixels() can be used without a texture or an ImGui context.
+struct PlotWaterfall {
+    enum class Colormap {
+        Grayscale,
+        Viridis,
+        Magma,
+        Jet,
+    };
+    // Colors in the lookup table
+    static const int lut_size = 256;
+
+    // Uploads rows [row, row + row_count) of the image to the texture.
+    // pixels points to the first of them, every row is width IM_COL32
+    // pixels. If *texture is null or its size changed, all rows are passed
+    // and the texture must be (re)created and stored in *texture. The image
+    // is a ring of rows, so the texture must repeat vertically (GL_REPEAT or
+    // similar).
+    void (*update_texture)(ImTextureID* texture, int width, int height, const ImU32* pixels, int row, int row_count, void* user_data) = nullptr;
+    void* user_data = nullptr;
+
+    PlotWaterfall();
+
+    // width is the number of values per row, rows the number of rows kept
+    void Init(int width, int rows);
+    // Sets all rows to the first color of the colormap
+    void Clear();
+    // Values mapped to the first and last color of the colormap. Changing
+    // it or the colormap converts all rows again.
+    void SetRange(float min, float max);
+    void SetColormap(Colormap colormap);
+    // count colors, spread evenly over the range
+    void SetColormap(const ImU32* colors, int count);
+    // Adds Width() values as the newest row
+    void PushRow(const float* values);
+
+    int Width() const { return width; }
+    int Rows() const { return rows; }
+    // Row of the image that holds the newest values, Head() + 1 (wrapping
+    // around) the ones before
+    int Head() const { return head; }
+    // Width() * Rows() pixels, row after row
+    const ImU32* Pixels() const { return pixels.Data; }
+    ImTextureID Texture() const { return texture; }
+
+    // Passes the rows pushed since the last call to update_texture
+    void UpdateTexture();
+    // Updates the texture and draws the image, newest row at the top. A
+    // size of -1 fills the window, a height of 0 draws one pixel per row.
+    void Draw(const char* label, const ImVec2& size = ImVec2(-1.f, 0.f));
+
+private:
+    void ConvertRow(int row);
+
+    ImVector<float> values;
+    ImVector<ImU32> pixels;
+    ImU32 lut[lut_size];
+    float min = 0.0f;
+    float max = 1.0f;
+    float lut_scale = lut_size - 1;
+    int width = 0;
+    int rows = 0;
+    int head = 0;
+    int dirty_rows = 0; // pushed since the last upload
+    bool dirty_all = true;
+    ImTextureID texture = ImTextureID();
+    int texture_width = 0;
+    int texture_height = 0;
+};
+}
@@ -4,6 +4,33 @@
 #define IMGUI_DEFINE_MATH_OPERATORS
 #endif
 #include <imgui_internal.h>
+#include <atomic>
+#include <cstdlib>
+#ifndef IMGUI_PLOT_DISABLE_STATS
+#include <chrono>
+#endif
+
+// Vectorized sample kernels are picked at compile time from the enabled
+// instruction sets. Define IMGUI_PLOT_DISABLE_SIMD to use the scalar code only.
+#if !defined(IMGUI_PLOT_DISABLE_SIMD)
+#if defined(__AVX2__)
+#define IMGUI_PLOT_AVX2
+#include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define IMGUI_PLOT_SSE2
+#include <emmintrin.h>
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#define IMGUI_PLOT_NEON
+#include <arm_neon.h>
+#endif
+#endif
+
+// PlotStats counters only exist if IMGUI_PLOT_DISABLE_STATS isn't defined
+#ifndef IMGUI_PLOT_DISABLE_STATS
+#define IMGUI_PLOT_STAT(_EXPR) _EXPR
+#else
+#define IMGUI_PLOT_STAT(_EXPR)
+#endif
 
 namespace ImGui {
 // [0..1] -> [0..1]
@@ -33,54 +60,1797 @@ template<typename T> static inline T lerp_inv(T a, T b, T l) {
     return static_cast<T>((l - a) / (b - a));
 }
 
-static size_t cursor_to_idx(const ImVec2& pos, const ImRect& bb, const PlotConfig& conf, float x_min, float x_max) {
+// Buffer index of sample i, following the ring buffer wraparound
+static inline size_t sample_index(const PlotConfig::Values& values, size_t i) {
+    return values.capacity ? (values.head + i) % values.capacity : i;
+}
+
+static inline float sample_x(const PlotConfig::Values& values, size_t i) {
+    return values.xs.IsNullptr() ? static_cast<float>(i) : values.xs[sample_index(values, i)];
+}
+
+static inline float sample_y(const PlotConfig::Values& values, const PlotConfig::Buffer& ys, size_t i) {
+    return ys[sample_index(values, i)];
+}
+
+// Index of the sample nearest to x, xs must be sorted. The search starts
+// at hint (e.g. last frame's result) and widens exponentially from there,
+// so small cursor movements only cost a few comparisons.
+static size_t find_nearest(const PlotConfig::Values& values, float x, size_t hint) {
+    const size_t count = values.count;
+    hint = ImMin(hint, count - 1);
+
+    // bracket x between lo and hi with sample_x(lo) <= x < sample_x(hi)
+    size_t lo, hi;
+    size_t step = 1;
+    if (sample_x(values, hint) <= x) {
+        lo = hint;
+        hi = hint + step;
+        while (hi < count && sample_x(values, hi) <= x) {
+            lo = hi;
+            step *= 2;
+            hi = lo + step;
+        }
+        hi = ImMin(hi, count);
+    }
+    else {
+        hi = hint;
+        while (hi > step && sample_x(values, hi - step) > x) {
+            hi -= step;
+            step *= 2;
+        }
+        lo = hi > step ? hi - step : 0;
+        if (sample_x(values, lo) > x) {
+            return lo;
+        }
+    }
+
+    while (hi - lo > 1) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (sample_x(values, mid) <= x) lo = mid;
+        else hi = mid;
+    }
+    if (hi < count && sample_x(values, hi) - x < x - sample_x(values, lo)) {
+        return hi;
+    }
+    return lo;
+}
+
+static size_t cursor_to_idx(const ImVec2& pos, const ImRect& bb, const PlotConfig& conf, float x_min, float x_max, size_t hint) {
     const float t = ImClamp(lerp_inv(bb.Min.x, bb.Max.x, pos.x), 0.0f, 0.9999f);
     const float x = ImLerp(x_min, x_max, rescale_inv(t, x_min, x_max, conf.scale.type));
 
     size_t v_idx;
     if (conf.values.xs.IsNullptr()) {
-        v_idx = static_cast<size_t>(x + 0.5);
+        v_idx = static_cast<size_t>(ImClamp(x + 0.5f, 0.0f, static_cast<float>(conf.values.count - 1)));
     }
     else {
-        v_idx = 0;
-        float closest_dist = x_max - x_min;
-        for (size_t i = 0; i < conf.values.count; i++)
-        {
-            float dist = x - conf.values.xs[i];
-            if (ImFabs(dist) < closest_dist) {
-                v_idx = i;
-                closest_dist = dist;
-            }
-            // xs is sorted so we can quit here:
-            else if (dist < 0) {
-                break;
-            }
-        }
+        v_idx = find_nearest(conf.values, x, hint);
     }
 
-    IM_ASSERT(v_idx >= 0 && v_idx < conf.values.count);
+    IM_ASSERT(v_idx < conf.values.count);
 
     return v_idx;
 }
 
+// First sample with an x value not below x, xs must be sorted
+static size_t lower_bound_x(const PlotConfig::Values& values, float x) {
+    size_t lo = 0, hi = values.count;
+    while (lo < hi) {
+        const size_t mid = lo + (hi - lo) / 2;
+        if (sample_x(values, mid) < x) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+// Samples [first, last) needed to draw the x range [x_min, x_max], with one
+// more sample on each side so lines leaving the plot aren't cut short
+static void visible_range(const PlotConfig::Values& values, float x_min, float x_max, size_t* first, size_t* last) {
+    if (values.xs.IsNullptr()) {
+        const float max_idx = static_cast<float>(values.count - 1);
+        *first = static_cast<size_t>(ImClamp(floorf(x_min), 0.0f, max_idx));
+        *last = static_cast<size_t>(ImClamp(ceilf(x_max), 0.0f, max_idx)) + 1;
+    }
+    else {
+        *first = lower_bound_x(values, x_min);
+        if (*first > 0) --*first;
+        *last = ImMin(lower_bound_x(values, x_max) + 1, values.count);
+    }
+}
+
+// Address of element i, honouring offset and stride
+template<typename T> static inline const T* element_ptr(const PlotConfig::Buffer& buf, size_t i) {
+    const size_t stride = buf.stride ? buf.stride : sizeof(T);
+    return reinterpret_cast<const T*>(static_cast<const char*>(buf.raw) + buf.offset + i * stride);
+}
+
+// Whether the elements are laid out like a plain array
+template<typename T> static inline bool is_packed(const PlotConfig::Buffer& buf) {
+    return buf.stride == 0 || buf.stride == sizeof(T);
+}
+
 // Helper to read an array index as the correct type
 const float PlotConfig::Buffer::operator[](size_t i) const
 {
     switch (this->type)
     {
     case PlotConfig::Buffer::Type::float32:
-        return this->float32[i];
+        return *element_ptr<float>(*this, i);
     case PlotConfig::Buffer::Type::float64:
-        return static_cast<float>(this->float64[i]);
+        return static_cast<float>(*element_ptr<double>(*this, i));
     case PlotConfig::Buffer::Type::int32:
-        return static_cast<float>(this->int32[i]);
+        return static_cast<float>(*element_ptr<int32_t>(*this, i));
+    case PlotConfig::Buffer::Type::int16:
+        return static_cast<float>(*element_ptr<int16_t>(*this, i));
+    case PlotConfig::Buffer::Type::uint16:
+        return static_cast<float>(*element_ptr<uint16_t>(*this, i));
+    case PlotConfig::Buffer::Type::uint8:
+        return static_cast<float>(*element_ptr<uint8_t>(*this, i));
+    case PlotConfig::Buffer::Type::int64:
+        return static_cast<float>(*element_ptr<int64_t>(*this, i));
+    case PlotConfig::Buffer::Type::uint32:
+        return static_cast<float>(*element_ptr<uint32_t>(*this, i));
     default:
         return .0f;
     }
 }
 
-PlotStatus Plot(const char* label, const PlotConfig& conf) {
+// Number of samples converted per kernel call
+static const size_t block_size = 256;
+
+// Converts n consecutive elements starting at first into floats
+typedef void (*LoadFn)(const PlotConfig::Buffer& buf, size_t first, size_t n, float* out);
+
+template<typename T> static void load_block(const PlotConfig::Buffer& buf, size_t first, size_t n, float* out) {
+    const T* src = element_ptr<T>(buf, first);
+    if (is_packed<T>(buf)) {
+        for (size_t i = 0; i < n; i++) {
+            out[i] = static_cast<float>(src[i]);
+        }
+    }
+    else {
+        const char* p = reinterpret_cast<const char*>(src);
+        for (size_t i = 0; i < n; i++, p += buf.stride) {
+            out[i] = static_cast<float>(*reinterpret_cast<const T*>(p));
+        }
+    }
+}
+
+// Used when no x values are given, the sample index is the x value
+static void load_index_block(const PlotConfig::Buffer&, size_t first, size_t n, float* out) {
+    for (size_t i = 0; i < n; i++) {
+        out[i] = static_cast<float>(first + i);
+    }
+}
+
+// log2 of a positive normal float. x is split into 2^e * m with m in
+// [sqrt(1/2), sqrt(2)), and log2(m) is 2 / ln(2) * atanh(s) with
+// s = (m - 1) / (m + 1), |s| < 0.172, summed up to s^7. The series error is
+// below 3e-8, so float rounding dominates: the absolute error is below 5e-7
+// for x in [2^-8, 2^8] and below 4e-6 (half an ulp of the result) elsewhere.
+// x <= 0 and NaN give -inf, so such samples end up off the plot and break
+// the line instead of being drawn somewhere.
+static inline float fast_log2(float x) {
+    if (!(x > 0.0f))
+        return -INFINITY;
+    uint32_t bits;
+    memcpy(&bits, &x, sizeof(bits));
+    int e = static_cast<int>((bits >> 23) & 0xff) - 127;
+    bits = (bits & 0x007fffff) | 0x3f800000;
+    float m;
+    memcpy(&m, &bits, sizeof(m));
+    if (m > 1.41421356f) {
+        m *= 0.5f;
+        e += 1;
+    }
+    const float s = (m - 1.0f) / (m + 1.0f);
+    const float s2 = s * s;
+    return static_cast<float>(e) + s * (2.88539008f + s2 * (0.961796694f + s2 * (0.577078016f + s2 * 0.412198583f)));
+}
+
+// Per-series constants of the data to screen transform. Log10 axes map
+// log2(sample / min) instead of subtracting an offset, log2(sample) -
+// log2(min) would cancel out on narrow ranges of large values. Their
+// factors are pixels per log2 unit.
+struct ScreenTransform {
+    ImRect bb;
+    float x_min; // subtracted on linear axes
+    float y_min;
+    float x_inv_min; // 1 / min, the samples of Log10 axes are scaled by it
+    float y_inv_min;
+    float kx; // pixels per x unit
+    float ky; // pixels per y unit
+};
+
+// Converts n (x, y) pairs into screen positions
+typedef void (*MapFn)(const ScreenTransform& tf, const float* xs, const float* ys, size_t n, ImVec2* out);
+
+template<PlotConfig::Scale::Type SX, PlotConfig::Scale::Type SY>
+static void map_block(const ScreenTransform& tf, const float* xs, const float* ys, size_t n, ImVec2* out) {
+    for (size_t i = 0; i < n; i++) {
+        const float x = SX == PlotConfig::Scale::Type::Log10 ? fast_log2(xs[i] * tf.x_inv_min) : xs[i] - tf.x_min;
+        const float y = SY == PlotConfig::Scale::Type::Log10 ? fast_log2(ys[i] * tf.y_inv_min) : ys[i] - tf.y_min;
+        out[i] = ImVec2(tf.bb.Min.x + x * tf.kx, tf.bb.Max.y - y * tf.ky);
+    }
+}
+
+#if defined(IMGUI_PLOT_AVX2) || defined(IMGUI_PLOT_SSE2) || defined(IMGUI_PLOT_NEON)
+#define IMGUI_PLOT_SIMD
+// Vector versions of fast_log2, with the same results
+#if defined(IMGUI_PLOT_AVX2)
+static inline __m256 fast_log2_simd(__m256 x) {
+    const __m256i bits = _mm256_castps_si256(x);
+    __m256i e = _mm256_sub_epi32(_mm256_srli_epi32(bits, 23), _mm256_set1_epi32(127));
+    __m256 m = _mm256_castsi256_ps(_mm256_or_si256(_mm256_and_si256(bits, _mm256_set1_epi32(0x007fffff)), _mm256_set1_epi32(0x3f800000)));
+    const __m256 big = _mm256_cmp_ps(m, _mm256_set1_ps(1.41421356f), _CMP_GT_OQ);
+    m = _mm256_blendv_ps(m, _mm256_mul_ps(m, _mm256_set1_ps(0.5f)), big);
+    e = _mm256_sub_epi32(e, _mm256_castps_si256(big)); // the mask is -1
+    const __m256 s = _mm256_div_ps(_mm256_sub_ps(m, _mm256_set1_ps(1.0f)), _mm256_add_ps(m, _mm256_set1_ps(1.0f)));
+    const __m256 s2 = _mm256_mul_ps(s, s);
+    __m256 p = _mm256_add_ps(_mm256_set1_ps(0.577078016f), _mm256_mul_ps(s2, _mm256_set1_ps(0.412198583f)));
+    p = _mm256_add_ps(_mm256_set1_ps(0.961796694f), _mm256_mul_ps(s2, p));
+    p = _mm256_add_ps(_mm256_set1_ps(2.88539008f), _mm256_mul_ps(s2, p));
+    const __m256 valid = _mm256_cmp_ps(x, _mm256_setzero_ps(), _CMP_GT_OQ);
+    return _mm256_blendv_ps(_mm256_set1_ps(-INFINITY), _mm256_add_ps(_mm256_cvtepi32_ps(e), _mm256_mul_ps(s, p)), valid);
+}
+#elif defined(IMGUI_PLOT_SSE2)
+static inline __m128 fast_log2_simd(__m128 x) {
+    const __m128i bits = _mm_castps_si128(x);
+    __m128i e = _mm_sub_epi32(_mm_srli_epi32(bits, 23), _mm_set1_epi32(127));
+    __m128 m = _mm_castsi128_ps(_mm_or_si128(_mm_and_si128(bits, _mm_set1_epi32(0x007fffff)), _mm_set1_epi32(0x3f800000)));
+    const __m128 big = _mm_cmpgt_ps(m, _mm_set1_ps(1.41421356f));
+    m = _mm_sub_ps(m, _mm_and_ps(big, _mm_mul_ps(m, _mm_set1_ps(0.5f))));
+    e = _mm_sub_epi32(e, _mm_castps_si128(big)); // the mask is -1
+    const __m128 s = _mm_div_ps(_mm_sub_ps(m, _mm_set1_ps(1.0f)), _mm_add_ps(m, _mm_set1_ps(1.0f)));
+    const __m128 s2 = _mm_mul_ps(s, s);
+    __m128 p = _mm_add_ps(_mm_set1_ps(0.577078016f), _mm_mul_ps(s2, _mm_set1_ps(0.412198583f)));
+    p = _mm_add_ps(_mm_set1_ps(0.961796694f), _mm_mul_ps(s2, p));
+    p = _mm_add_ps(_mm_set1_ps(2.88539008f), _mm_mul_ps(s2, p));
+    const __m128 valid = _mm_cmpgt_ps(x, _mm_setzero_ps());
+    const __m128 r = _mm_add_ps(_mm_cvtepi32_ps(e), _mm_mul_ps(s, p));
+    return _mm_or_ps(_mm_and_ps(valid, r), _mm_andnot_ps(valid, _mm_set1_ps(-INFINITY)));
+}
+#elif defined(IMGUI_PLOT_NEON)
+static inline float32x4_t fast_log2_simd(float32x4_t x) {
+    const uint32x4_t bits = vreinterpretq_u32_f32(x);
+    int32x4_t e = vsubq_s32(vreinterpretq_s32_u32(vshrq_n_u32(bits, 23)), vdupq_n_s32(127));
+    float32x4_t m = vreinterpretq_f32_u32(vorrq_u32(vandq_u32(bits, vdupq_n_u32(0x007fffff)), vdupq_n_u32(0x3f800000)));
+    const uint32x4_t big = vcgtq_f32(m, vdupq_n_f32(1.41421356f));
+    m = vbslq_f32(big, vmulq_f32(m, vdupq_n_f32(0.5f)), m);
+    e = vsubq_s32(e, vreinterpretq_s32_u32(big)); // the mask is -1
+    const float32x4_t num = vsubq_f32(m, vdupq_n_f32(1.0f));
+    const float32x4_t den = vaddq_f32(m, vdupq_n_f32(1.0f));
+#if defined(__aarch64__)
+    const float32x4_t s = vdivq_f32(num, den);
+#else
+    float32x4_t r = vrecpeq_f32(den);
+    r = vmulq_f32(r, vrecpsq_f32(den, r));
+    r = vmulq_f32(r, vrecpsq_f32(den, r));
+    const float32x4_t s = vmulq_f32(num, r);
+#endif
+    const float32x4_t s2 = vmulq_f32(s, s);
+    float32x4_t p = vmlaq_f32(vdupq_n_f32(0.577078016f), s2, vdupq_n_f32(0.412198583f));
+    p = vmlaq_f32(vdupq_n_f32(0.961796694f), s2, p);
+    p = vmlaq_f32(vdupq_n_f32(2.88539008f), s2, p);
+    const uint32x4_t valid = vcgtq_f32(x, vdupq_n_f32(0.0f));
+    return vbslq_f32(valid, vmlaq_f32(vcvtq_f32_s32(e), s, p), vdupq_n_f32(-INFINITY));
+}
+#endif
+
+// Same as map_block, several samples at a time
+template<PlotConfig::Scale::Type SX, PlotConfig::Scale::Type SY>
+static void map_block_simd(const ScreenTransform& tf, const float* xs, const float* ys, size_t n, ImVec2* out) {
+    const bool log_x = SX == PlotConfig::Scale::Type::Log10;
+    const bool log_y = SY == PlotConfig::Scale::Type::Log10;
+    size_t i = 0;
+#if defined(IMGUI_PLOT_AVX2)
+    const __m256 x_min = _mm256_set1_ps(tf.x_min), x_inv_min = _mm256_set1_ps(tf.x_inv_min);
+    const __m256 y_min = _mm256_set1_ps(tf.y_min), y_inv_min = _mm256_set1_ps(tf.y_inv_min);
+    const __m256 kx = _mm256_set1_ps(tf.kx), x0 = _mm256_set1_ps(tf.bb.Min.x);
+    const __m256 ky = _mm256_set1_ps(tf.ky), y0 = _mm256_set1_ps(tf.bb.Max.y);
+    for (; i + 8 <= n; i += 8) {
+        const __m256 xv = _mm256_loadu_ps(xs + i), yv = _mm256_loadu_ps(ys + i);
+        const __m256 x = log_x ? fast_log2_simd(_mm256_mul_ps(xv, x_inv_min)) : _mm256_sub_ps(xv, x_min);
+        const __m256 y = log_y ? fast_log2_simd(_mm256_mul_ps(yv, y_inv_min)) : _mm256_sub_ps(yv, y_min);
+        const __m256 px = _mm256_add_ps(x0, _mm256_mul_ps(x, kx));
+        const __m256 py = _mm256_sub_ps(y0, _mm256_mul_ps(y, ky));
+        // unpack interleaves within 128-bit lanes, permute puts the lanes back in order
+        const __m256 lo = _mm256_unpacklo_ps(px, py);
+        const __m256 hi = _mm256_unpackhi_ps(px, py);
+        _mm256_storeu_ps(&out[i].x, _mm256_permute2f128_ps(lo, hi, 0x20));
+        _mm256_storeu_ps(&out[i + 4].x, _mm256_permute2f128_ps(lo, hi, 0x31));
+    }
+#elif defined(IMGUI_PLOT_SSE2)
+    const __m128 x_min = _mm_set1_ps(tf.x_min), x_inv_min = _mm_set1_ps(tf.x_inv_min);
+    const __m128 y_min = _mm_set1_ps(tf.y_min), y_inv_min = _mm_set1_ps(tf.y_inv_min);
+    const __m128 kx = _mm_set1_ps(tf.kx), x0 = _mm_set1_ps(tf.bb.Min.x);
+    const __m128 ky = _mm_set1_ps(tf.ky), y0 = _mm_set1_ps(tf.bb.Max.y);
+    for (; i + 4 <= n; i += 4) {
+        const __m128 xv = _mm_loadu_ps(xs + i), yv = _mm_loadu_ps(ys + i);
+        const __m128 x = log_x ? fast_log2_simd(_mm_mul_ps(xv, x_inv_min)) : _mm_sub_ps(xv, x_min);
+        const __m128 y = log_y ? fast_log2_simd(_mm_mul_ps(yv, y_inv_min)) : _mm_sub_ps(yv, y_min);
+        const __m128 px = _mm_add_ps(x0, _mm_mul_ps(x, kx));
+        const __m128 py = _mm_sub_ps(y0, _mm_mul_ps(y, ky));
+        _mm_storeu_ps(&out[i].x, _mm_unpacklo_ps(px, py));
+        _mm_storeu_ps(&out[i + 2].x, _mm_unpackhi_ps(px, py));
+    }
+#elif defined(IMGUI_PLOT_NEON)
+    const float32x4_t x_min = vdupq_n_f32(tf.x_min), x_inv_min = vdupq_n_f32(tf.x_inv_min);
+    const float32x4_t y_min = vdupq_n_f32(tf.y_min), y_inv_min = vdupq_n_f32(tf.y_inv_min);
+    const float32x4_t kx = vdupq_n_f32(tf.kx), x0 = vdupq_n_f32(tf.bb.Min.x);
+    const float32x4_t ky = vdupq_n_f32(tf.ky), y0 = vdupq_n_f32(tf.bb.Max.y);
+    for (; i + 4 <= n; i += 4) {
+        const float32x4_t xv = vld1q_f32(xs + i), yv = vld1q_f32(ys + i);
+        const float32x4_t x = log_x ? fast_log2_simd(vmulq_f32(xv, x_inv_min)) : vsubq_f32(xv, x_min);
+        const float32x4_t y = log_y ? fast_log2_simd(vmulq_f32(yv, y_inv_min)) : vsubq_f32(yv, y_min);
+        float32x4x2_t p;
+        p.val[0] = vaddq_f32(x0, vmulq_f32(x, kx));
+        p.val[1] = vsubq_f32(y0, vmulq_f32(y, ky));
+        vst2q_f32(&out[i].x, p);
+    }
+#endif
+    map_block<SX, SY>(tf, xs + i, ys + i, n - i, out + i);
+}
+
+static void load_block_int32_simd(const PlotConfig::Buffer& buf, size_t first, size_t n, float* out) {
+    const int32_t* src = element_ptr<int32_t>(buf, first);
+    size_t i = 0;
+#if defined(IMGUI_PLOT_AVX2)
+    for (; i + 8 <= n; i += 8) {
+        _mm256_storeu_ps(out + i, _mm256_cvtepi32_ps(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i))));
+    }
+#elif defined(IMGUI_PLOT_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, _mm_cvtepi32_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i))));
+    }
+#elif defined(IMGUI_PLOT_NEON)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vcvtq_f32_s32(vld1q_s32(src + i)));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = static_cast<float>(src[i]);
+    }
+}
+
+static void load_block_float64_simd(const PlotConfig::Buffer& buf, size_t first, size_t n, float* out) {
+    const double* src = element_ptr<double>(buf, first);
+    size_t i = 0;
+#if defined(IMGUI_PLOT_AVX2)
+    for (; i + 4 <= n; i += 4) {
+        _mm_storeu_ps(out + i, _mm256_cvtpd_ps(_mm256_loadu_pd(src + i)));
+    }
+#elif defined(IMGUI_PLOT_SSE2)
+    for (; i + 4 <= n; i += 4) {
+        const __m128 lo = _mm_cvtpd_ps(_mm_loadu_pd(src + i));
+        const __m128 hi = _mm_cvtpd_ps(_mm_loadu_pd(src + i + 2));
+        _mm_storeu_ps(out + i, _mm_movelh_ps(lo, hi));
+    }
+#elif defined(IMGUI_PLOT_NEON) && defined(__aarch64__)
+    for (; i + 4 <= n; i += 4) {
+        vst1q_f32(out + i, vcombine_f32(vcvt_f32_f64(vld1q_f64(src + i)), vcvt_f32_f64(vld1q_f64(src + i + 2))));
+    }
+#endif
+    for (; i < n; i++) {
+        out[i] = static_cast<float>(src[i]);
+    }
+}
+#endif
+
+static LoadFn select_loader(const PlotConfig::Buffer& buf) {
+    if (buf.IsNullptr())
+        return load_index_block;
+    switch (buf.type) {
+    case PlotConfig::Buffer::Type::float32: return load_block<float>;
+#ifdef IMGUI_PLOT_SIMD
+    // the vectorized loaders need plain arrays
+    case PlotConfig::Buffer::Type::float64: return is_packed<double>(buf) ? load_block_float64_simd : load_block<double>;
+    case PlotConfig::Buffer::Type::int32: return is_packed<int32_t>(buf) ? load_block_int32_simd : load_block<int32_t>;
+#else
+    case PlotConfig::Buffer::Type::float64: return load_block<double>;
+    case PlotConfig::Buffer::Type::int32: return load_block<int32_t>;
+#endif
+    case PlotConfig::Buffer::Type::int16: return load_block<int16_t>;
+    case PlotConfig::Buffer::Type::uint16: return load_block<uint16_t>;
+    case PlotConfig::Buffer::Type::uint8: return load_block<uint8_t>;
+    case PlotConfig::Buffer::Type::int64: return load_block<int64_t>;
+    case PlotConfig::Buffer::Type::uint32: return load_block<uint32_t>;
+    }
+    return load_index_block;
+}
+
+// Maps samples of a single series into the plot rectangle. Sample types and
+// scale are resolved once here, so the per-sample loops don't branch on them.
+struct SeriesMapper {
+    PlotConfig::Buffer xs;
+    PlotConfig::Buffer ys;
+    LoadFn load_x;
+    LoadFn load_y;
+    MapFn map;
+    ScreenTransform tf;
+    size_t capacity;
+    size_t head;
+    size_t* visited; // counts the samples read for PlotStats, may be null
+
+    // Loads samples [first, first + n), split in two at the ring buffer end
+    void Load(LoadFn load, const PlotConfig::Buffer& buf, size_t first, size_t n, float* out) const {
+        if (capacity == 0 || buf.IsNullptr()) {
+            load(buf, first, n, out);
+            return;
+        }
+        const size_t start = (head + first) % capacity;
+        const size_t n0 = ImMin(n, capacity - start);
+        load(buf, start, n0, out);
+        if (n0 < n) {
+            load(buf, 0, n - n0, out + n0);
+        }
+    }
+
+    // n must not exceed block_size
+    void Map(size_t first, size_t n, ImVec2* out) const {
+        float bx[block_size];
+        float by[block_size];
+        Load(load_x, xs, first, n, bx);
+        Load(load_y, ys, first, n, by);
+        map(tf, bx, by, n, out);
+        IMGUI_PLOT_STAT(if (visited) *visited += n);
+    }
+
+    ImVec2 operator()(size_t n) const {
+        ImVec2 p;
+        Map(n, 1, &p);
+        return p;
+    }
+
+    // Calls fn(index, position) for every sample in [first, last)
+    template<typename Fn> void ForEach(size_t first, size_t last, Fn fn) const {
+        ImVec2 pts[block_size];
+        for (size_t b = first; b < last; b += block_size) {
+            const size_t n = ImMin(block_size, last - b);
+            Map(b, n, pts);
+            for (size_t k = 0; k < n; k++) {
+                fn(b + k, pts[k]);
+            }
+        }
+    }
+};
+
+template<PlotConfig::Scale::Type SX, PlotConfig::Scale::Type SY> static MapFn select_map() {
+#ifdef IMGUI_PLOT_SIMD
+    return map_block_simd<SX, SY>;
+#else
+    return map_block<SX, SY>;
+#endif
+}
+
+// Offset, Log10 scale and pixel factor of one axis, see ScreenTransform
+static void axis_transform(PlotConfig::Scale::Type type, float min, float max, float pixels, float* offset, float* inv_min,
+    float* factor) {
+    if (type == PlotConfig::Scale::Type::Log10) {
+        *offset = 0.0f;
+        *inv_min = 1.0f / min;
+        const float range = fast_log2(max * *inv_min);
+        *factor = (min == max) ? 0.0f : pixels / range;
+        return;
+    }
+    *offset = min;
+    *inv_min = 1.0f;
+    *factor = (min == max) ? 0.0f : pixels / (max - min);
+}
+
+static SeriesMapper make_mapper(const PlotConfig& conf, const PlotConfig::Buffer& ys, const ImRect& bb, float x_min, float x_max,
+    float y_min, float y_max) {
+    typedef PlotConfig::Scale::Type Type;
+    SeriesMapper m;
+    m.xs = conf.values.xs;
+    m.ys = ys;
+    m.load_x = select_loader(conf.values.xs);
+    m.load_y = select_loader(ys);
+    m.capacity = conf.values.capacity;
+    m.head = conf.values.head;
+    m.visited = nullptr;
+    m.tf.bb = bb;
+    axis_transform(conf.scale.type, x_min, x_max, bb.GetWidth(), &m.tf.x_min, &m.tf.x_inv_min, &m.tf.kx);
+    axis_transform(conf.scale.type_y, y_min, y_max, bb.GetHeight(), &m.tf.y_min, &m.tf.y_inv_min, &m.tf.ky);
+    if (conf.scale.type == Type::Log10)
+        m.map = conf.scale.type_y == Type::Log10 ? select_map<Type::Log10, Type::Log10>() : select_map<Type::Log10, Type::Linear>();
+    else
+        m.map = conf.scale.type_y == Type::Log10 ? select_map<Type::Linear, Type::Log10>() : select_map<Type::Linear, Type::Linear>();
+    return m;
+}
+
+// Widens [*min, *max] to the n values, NaNs are skipped
+static void min_max_block(const float* v, size_t n, float* min, float* max) {
+    float lo = *min, hi = *max;
+    size_t i = 0;
+#if defined(IMGUI_PLOT_AVX2)
+    if (n >= 8) {
+        // the accumulator is the second operand, so NaN samples leave it unchanged
+        __m256 vlo = _mm256_set1_ps(lo), vhi = _mm256_set1_ps(hi);
+        for (; i + 8 <= n; i += 8) {
+            const __m256 x = _mm256_loadu_ps(v + i);
+            vlo = _mm256_min_ps(x, vlo);
+            vhi = _mm256_max_ps(x, vhi);
+        }
+        float l[8], h[8];
+        _mm256_storeu_ps(l, vlo);
+        _mm256_storeu_ps(h, vhi);
+        for (int k = 0; k < 8; k++) { lo = ImMin(lo, l[k]); hi = ImMax(hi, h[k]); }
+    }
+#elif defined(IMGUI_PLOT_SSE2)
+    if (n >= 4) {
+        __m128 vlo = _mm_set1_ps(lo), vhi = _mm_set1_ps(hi);
+        for (; i + 4 <= n; i += 4) {
+            const __m128 x = _mm_loadu_ps(v + i);
+            vlo = _mm_min_ps(x, vlo);
+            vhi = _mm_max_ps(x, vhi);
+        }
+        float l[4], h[4];
+        _mm_storeu_ps(l, vlo);
+        _mm_storeu_ps(h, vhi);
+        for (int k = 0; k < 4; k++) { lo = ImMin(lo, l[k]); hi = ImMax(hi, h[k]); }
+    }
+#elif defined(IMGUI_PLOT_NEON) && defined(__aarch64__)
+    if (n >= 4) {
+        // the nm variants return the number when one operand is NaN
+        float32x4_t vlo = vdupq_n_f32(lo), vhi = vdupq_n_f32(hi);
+        for (; i + 4 <= n; i += 4) {
+            const float32x4_t x = vld1q_f32(v + i);
+            vlo = vminnmq_f32(x, vlo);
+            vhi = vmaxnmq_f32(x, vhi);
+        }
+        lo = ImMin(lo, vminvq_f32(vlo));
+        hi = ImMax(hi, vmaxvq_f32(vhi));
+    }
+#endif
+    for (; i < n; i++) {
+        if (v[i] < lo) lo = v[i];
+        if (v[i] > hi) hi = v[i];
+    }
+    *min = lo;
+    *max = hi;
+}
+
+// Widens [*min, *max] to the y samples [first, last) of a series
+static void series_min_max(const SeriesMapper& map, size_t first, size_t last, float* min, float* max) {
+    float ys[block_size];
+    for (size_t b = first; b < last; b += block_size) {
+        const size_t n = ImMin(block_size, last - b);
+        map.Load(map.load_y, map.ys, b, n, ys);
+        min_max_block(ys, n, min, max);
+        IMGUI_PLOT_STAT(if (map.visited) *map.visited += n);
+    }
+}
+
+// Estimates the y range of samples [first, last) from about count of them
+static void series_min_max_sampled(const SeriesMapper& map, size_t first, size_t last, size_t count, float* min, float* max) {
+    const size_t step = ImMax(static_cast<size_t>(1), (last - first) / count);
+    for (size_t n = first; n < last; n += step) {
+        float y;
+        map.Load(map.load_y, map.ys, n, 1, &y);
+        if (y < *min) *min = y;
+        if (y > *max) *max = y;
+    }
+}
+
+// 1, 2 or 5 times a power of ten, close to x
+static float nice_step(float x) {
+    const float e = powf(10.0f, floorf(log10f(x)));
+    const float f = x / e;
+    return (f < 1.5f ? 1.0f : f < 3.0f ? 2.0f : f < 7.0f ? 5.0f : 10.0f) * e;
+}
+
+// Pads the range of the samples and rounds it outwards as Scale asks for
+static void fit_range(const PlotConfig::Scale& scale, float* min, float* max) {
+    const bool log = scale.type_y == PlotConfig::Scale::Type::Log10;
+    float lo = *min, hi = *max;
+    if (log) {
+        // samples <= 0 can't be shown on a log axis
+        if (!(hi > 0.0f)) { *min = 1.0f; *max = 10.0f; return; }
+        lo = log10f(lo > 0.0f ? lo : hi * 1e-6f);
+        hi = log10f(hi);
+    }
+    if (lo == hi) {
+        const float half = lo != 0.0f ? ImFabs(lo) * 0.5f : 0.5f;
+        lo -= half;
+        hi += half;
+    }
+    const float pad = (hi - lo) * scale.auto_fit_padding;
+    lo -= pad;
+    hi += pad;
+    if (scale.auto_fit_nice) {
+        const float step = log ? 1.0f : nice_step((hi - lo) / 5.0f);
+        lo = floorf(lo / step) * step;
+        hi = ceilf(hi / step) * step;
+    }
+    *min = log ? powf(10.0f, lo) : lo;
+    *max = log ? powf(10.0f, hi) : hi;
+}
+
+// Growable array of screen positions filled by PlotConfig::Parallel
+// workers. ImGui's allocator must only be used on the UI thread, so this
+// one uses malloc.
+struct PointBuffer {
+    ImVec2* Data = nullptr;
+    int Size = 0;
+    int Capacity = 0;
+
+    PointBuffer() {}
+    PointBuffer(const PointBuffer&) = delete;
+    PointBuffer& operator=(const PointBuffer&) = delete;
+    ~PointBuffer() { free(Data); }
+
+    ImVec2& operator[](int i) { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    const ImVec2& operator[](int i) const { IM_ASSERT(i >= 0 && i < Size); return Data[i]; }
+    const ImVec2& back() const { IM_ASSERT(Size > 0); return Data[Size - 1]; }
+
+    void reserve(int n) {
+        if (n <= Capacity) return;
+        ImVec2* data = static_cast<ImVec2*>(realloc(Data, static_cast<size_t>(n) * sizeof(ImVec2)));
+        IM_ASSERT(data);
+        Data = data;
+        Capacity = n;
+    }
+    void resize(int n) {
+        reserve(n);
+        Size = n;
+    }
+    void push_back(const ImVec2& p) {
+        if (Size == Capacity) reserve(Capacity ? Capacity * 2 : 256);
+        Data[Size++] = p;
+    }
+};
+
+// False for NaN samples and samples <= 0 on Log10 axes
+static bool is_finite(const ImVec2& p) {
+    return p.x - p.x == 0.0f && p.y - p.y == 0.0f;
+}
+
+// Keeps the lowest and highest sample of every pixel column, in sample order.
+// A run of points that aren't finite is kept as one of them, to break the
+// line there.
+static void decimate_min_max(const SeriesMapper& map, size_t first, size_t last, PointBuffer& out) {
+    out.resize(0);
+    const float x0 = map.tf.bb.Min.x;
+    ImVec2 lo, hi;
+    // as float, points far outside the plot would overflow an int
+    float column = 0.0f;
+    bool open = false; // lo and hi hold a column
+    size_t lo_idx = 0, hi_idx = 0;
+    auto flush = [&]() {
+        if (lo_idx == hi_idx) {
+            out.push_back(lo);
+        }
+        else if (lo_idx < hi_idx) {
+            out.push_back(lo);
+            out.push_back(hi);
+        }
+        else {
+            out.push_back(hi);
+            out.push_back(lo);
+        }
+    };
+    map.ForEach(first, last, [&](size_t n, const ImVec2& p) {
+        if (!is_finite(p)) {
+            if (open) flush();
+            else if (out.Size > 0 && !is_finite(out.back())) return;
+            out.push_back(p);
+            open = false;
+            return;
+        }
+        const float c = floorf(p.x - x0);
+        if (open && c == column) {
+            // screen y grows downwards
+            if (p.y < hi.y) { hi = p; hi_idx = n; }
+            if (p.y > lo.y) { lo = p; lo_idx = n; }
+            return;
+        }
+        if (open) flush();
+        column = c;
+        lo = hi = p;
+        lo_idx = hi_idx = n;
+        open = true;
+    });
+    if (open) flush();
+}
+
+// Largest triangle three buckets downsampling, see
+// Sveinn Steinarsson: "Downsampling Time Series for Visual Representation"
+// Points that aren't finite never become triangle corners, a bucket with
+// any of them emits one in sample order to break the line.
+static void decimate_lttb(const SeriesMapper& map, size_t first, size_t last, int buckets, PointBuffer& out) {
+    out.resize(0);
+    // first and last sample are always kept, the others are split into buckets
+    const double bucket_size = static_cast<double>(last - first - 2) / buckets;
+    ImVec2 a = map(first);
+    out.push_back(a);
+    // until the first finite sample, the first finite one of a bucket is picked
+    bool has_a = is_finite(a);
+    for (int b = 0; b < buckets; b++) {
+        const size_t bucket_first = first + static_cast<size_t>(b * bucket_size) + 1;
+        const size_t bucket_last = ImMin(first + static_cast<size_t>((b + 1) * bucket_size) + 1, last - 1);
+
+        // the third triangle corner is the average of the next bucket
+        ImVec2 avg = map(last - 1);
+        if (b + 1 < buckets) {
+            const size_t next_last = ImMin(first + static_cast<size_t>((b + 2) * bucket_size) + 1, last - 1);
+            ImVec2 sum(0.f, 0.f);
+            int n = 0;
+            map.ForEach(bucket_last, next_last, [&](size_t, const ImVec2& p) {
+                if (is_finite(p)) { sum = sum + p; n++; }
+            });
+            avg = n > 0 ? sum * (1.0f / n) : a;
+        }
+        if (!is_finite(avg)) avg = a;
+
+        float best_area = -1.0f;
+        ImVec2 best = a;
+        size_t best_idx = 0;
+        bool gap = false;
+        size_t gap_idx = 0;
+        ImVec2 gap_point;
+        map.ForEach(bucket_first, bucket_last, [&](size_t n, const ImVec2& p) {
+            if (!is_finite(p)) {
+                if (!gap) { gap = true; gap_idx = n; gap_point = p; }
+                return;
+            }
+            const float area = has_a ? ImFabs((a.x - avg.x) * (p.y - a.y) - (a.x - p.x) * (avg.y - a.y)) : 0.0f;
+            if (area > best_area) {
+                best_area = area;
+                best = p;
+                best_idx = n;
+            }
+        });
+        const bool found = best_area >= 0.0f;
+        // one break is enough for a run of buckets without finite samples
+        if (gap && !found && !is_finite(out.back())) continue;
+        if (gap && (!found || gap_idx < best_idx)) out.push_back(gap_point);
+        if (found) out.push_back(best);
+        if (gap && found && gap_idx > best_idx) out.push_back(gap_point);
+        if (found) {
+            a = best;
+            has_a = true;
+        }
+    }
+    out.push_back(map(last - 1));
+}
+
+// Every n-th sample, about two per pixel column. A placeholder for series
+// whose pyramid is still being built.
+static void decimate_stride(const SeriesMapper& map, size_t first, size_t last, int columns, PointBuffer& out) {
+    out.resize(0);
+    const size_t step = ImMax(static_cast<size_t>(1), (last - first) / (2 * static_cast<size_t>(columns)));
+    for (size_t n = first; n < last; n += step) {
+        out.push_back(map(n));
+    }
+    out.push_back(map(last - 1));
+}
+
+// Min/max pyramid over one y buffer. Every bucket of level 0 covers base
+// samples, every bucket of the levels above merges lod_fanout buckets of the
+// level below. Buckets store the minimum in x and the maximum in y.
+static const size_t lod_fanout = 4;
+static const int lod_max_levels = 24;
+
+// What a pyramid is built from
+struct LodKey {
+    PlotConfig::Buffer source;
+    const ImVec2* summary = nullptr; // LevelOfDetail::summaries entry
+    size_t summary_bucket = 0;
+    uint64_t generation = 0;
+    size_t base = 0;
+};
+
+struct LodPyramid : LodKey {
+    size_t count = 0;
+    int level_count = 0;
+    ImVector<ImVec2> levels[lod_max_levels];
+
+    size_t BucketSize(int level) const {
+        size_t size = base;
+        for (int l = 0; l < level; l++) size *= lod_fanout;
+        return size;
+    }
+
+    void Swap(LodPyramid& o) {
+        ImSwap(static_cast<LodKey&>(*this), static_cast<LodKey&>(o));
+        ImSwap(count, o.count);
+        ImSwap(level_count, o.level_count);
+        for (int l = 0; l < lod_max_levels; l++) levels[l].swap(o.levels[l]);
+    }
+};
+
+static bool same_buffer(const PlotConfig::Buffer& a, const PlotConfig::Buffer& b) {
+    return a.raw == b.raw && a.type == b.type && a.offset == b.offset && a.stride == b.stride;
+}
+
+// Smallest level 0 bucket size of at least min_base that keeps the pyramid
+// within budget bytes
+static size_t lod_base_for(size_t count, size_t budget, size_t min_base) {
+    size_t base = min_base;
+    // all levels together take about 4/3 of level 0
+    while ((count / base + 1) * sizeof(ImVec2) * 4 / 3 > budget && base < (static_cast<size_t>(1) << 40)) {
+        base *= lod_fanout;
+    }
+    return base;
+}
+
+// Allocates every level of a pyramid with the given base for count samples,
+// so that lod_update() up to count doesn't allocate. Background builds and
+// PlotConfig::Parallel workers rely on it, ImGui's allocator must only be
+// used on the UI thread.
+static void lod_reserve(LodPyramid& p, size_t base, size_t count) {
+    size_t n = (count + base - 1) / base;
+    for (int l = 0; l < lod_max_levels; l++) {
+        // grown like push_back does, or appending samples would copy the
+        // levels every frame
+        ImVector<ImVec2>& level = p.levels[l];
+        if (static_cast<int>(n) > level.Capacity) level.reserve(level._grow_capacity(static_cast<int>(n)));
+        if (n <= 1) break;
+        n = (n + lod_fanout - 1) / lod_fanout;
+    }
+}
+
+// Brings the pyramid up to date with the first count samples of map.ys.
+// Only buckets from sample `from` onwards are recomputed.
+static void lod_update(LodPyramid& p, const SeriesMapper& map, size_t count, size_t from) {
+    ImVector<ImVec2>& level0 = p.levels[0];
+    const size_t first_bucket = from / p.base;
+    level0.resize(static_cast<int>((count + p.base - 1) / p.base));
+
+    if (p.summary) {
+        // base is a multiple of the summary bucket size
+        const size_t ratio = p.base / p.summary_bucket;
+        const size_t entries = (count + p.summary_bucket - 1) / p.summary_bucket;
+        for (size_t j = first_bucket; j < static_cast<size_t>(level0.Size); j++) {
+            const size_t end = ImMin((j + 1) * ratio, entries);
+            ImVec2 bucket = p.summary[j * ratio];
+            for (size_t e = j * ratio + 1; e < end; e++) {
+                bucket.x = ImMin(bucket.x, p.summary[e].x);
+                bucket.y = ImMax(bucket.y, p.summary[e].y);
+            }
+            level0[static_cast<int>(j)] = bucket;
+        }
+    }
+    else {
+        float ys[block_size];
+        for (size_t b = first_bucket * p.base; b < count; b += block_size) {
+            const size_t n = ImMin(block_size, count - b);
+            map.load_y(map.ys, b, n, ys);
+            IMGUI_PLOT_STAT(if (map.visited) *map.visited += n);
+            for (size_t k = 0; k < n; k++) {
+                const size_t i = b + k;
+                ImVec2& bucket = level0[static_cast<int>(i / p.base)];
+                if (i % p.base == 0) {
+                    bucket = ImVec2(ys[k], ys[k]);
+                }
+                else {
+                    bucket.x = ImMin(bucket.x, ys[k]);
+                    bucket.y = ImMax(bucket.y, ys[k]);
+                }
+            }
+        }
+    }
+
+    size_t first = first_bucket;
+    p.level_count = 1;
+    for (int l = 1; l < lod_max_levels && p.levels[l - 1].Size > 1; l++) {
+        const ImVector<ImVec2>& below = p.levels[l - 1];
+        ImVector<ImVec2>& level = p.levels[l];
+        level.resize((below.Size + static_cast<int>(lod_fanout) - 1) / static_cast<int>(lod_fanout));
+        first /= lod_fanout;
+        for (int j = static_cast<int>(first); j < level.Size; j++) {
+            const int end = ImMin((j + 1) * static_cast<int>(lod_fanout), below.Size);
+            ImVec2 bucket = below[j * static_cast<int>(lod_fanout)];
+            for (int c = j * static_cast<int>(lod_fanout) + 1; c < end; c++) {
+                bucket.x = ImMin(bucket.x, below[c].x);
+                bucket.y = ImMax(bucket.y, below[c].y);
+            }
+            level[j] = bucket;
+        }
+        p.level_count = l + 1;
+    }
+    p.count = count;
+}
+
+// Whether a pyramid of p_count samples can be brought up to date without
+// a rebuild. The generation only matters if samples can change in place.
+static bool lod_extends(const LodKey& p, size_t p_count, const LodKey& key, size_t count, bool append_only) {
+    return same_buffer(p.source, key.source) && p.summary == key.summary && p.summary_bucket == key.summary_bucket &&
+        p.base == key.base && p_count <= count && (append_only || (p_count == count && p.generation == key.generation));
+}
+
+// Makes sure the pyramid describes the current data, rebuilding or
+// extending it as necessary
+static void lod_sync(LodPyramid& p, const SeriesMapper& map, const LodKey& key, size_t count, bool append_only) {
+    if (!lod_extends(p, p.count, key, count, append_only)) {
+        static_cast<LodKey&>(p) = key;
+        lod_update(p, map, count, 0);
+    }
+    else if (count > p.count) {
+        lod_update(p, map, count, p.count);
+    }
+}
+
+// Pyramid built by a LevelOfDetail::submit job. The job owns it until it
+// sets done and never touches it after that. It's allocated and deleted on
+// the UI thread only, the job just fills the levels reserved for it.
+struct LodBuild {
+    LodPyramid pyramid; // the key is set and the levels reserved before submitting
+    SeriesMapper map;
+    size_t count = 0;
+    std::atomic<size_t> progress; // samples summarized so far
+    std::atomic<bool> cancel;
+    std::atomic<bool> done;
+
+    LodBuild() : progress(0), cancel(false), done(false) {}
+};
+
+// Background jobs that have not returned yet, including cancelled ones
+static std::atomic<int> lod_jobs_running(0);
+// Builds let go of while their job was still running, deleted once it's done
+static ImVector<LodBuild*> lod_orphans;
+
+// Deletes the orphaned builds whose job is done
+static void lod_collect() {
+    for (int i = lod_orphans.Size - 1; i >= 0; i--) {
+        if (lod_orphans[i]->done.load(std::memory_order_acquire)) {
+            IM_DELETE(lod_orphans[i]);
+            lod_orphans.erase(lod_orphans.Data + i);
+        }
+    }
+}
+
+// Cancels the build and deletes it as soon as its job allows
+static void lod_release(LodBuild* build) {
+    build->cancel.store(true, std::memory_order_relaxed);
+    if (build->done.load(std::memory_order_acquire)) {
+        IM_DELETE(build);
+    }
+    else {
+        lod_orphans.push_back(build);
+    }
+}
+
+static void lod_build_job(void* data) {
+    LodBuild* build = static_cast<LodBuild*>(data);
+    // the cancel flag is checked between chunks
+    const size_t chunk = static_cast<size_t>(1) << 20;
+    for (size_t from = 0; from < build->count && !build->cancel.load(std::memory_order_relaxed); from += chunk) {
+        const size_t to = ImMin(from + chunk, build->count);
+        lod_update(build->pyramid, build->map, to, from);
+        build->progress.store(to, std::memory_order_relaxed);
+    }
+    // the UI thread may delete the build from here on
+    build->done.store(true, std::memory_order_release);
+    lod_jobs_running.fetch_sub(1, std::memory_order_release);
+}
+
+// Emits the min/max envelope of samples [first, last) from the coarsest
+// level that still has a bucket per pixel column. Returns false if even
+// level 0 is too coarse, the raw samples have to be used then.
+static bool decimate_lod(const LodPyramid& p, const PlotConfig::Values& values, const SeriesMapper& map,
+    size_t first, size_t last, int columns, PointBuffer& out) {
+    const size_t visible = last - first;
+    int level = -1;
+    for (int l = 0; l < p.level_count; l++) {
+        if (visible / p.BucketSize(l) < static_cast<size_t>(columns)) break;
+        level = l;
+    }
+    if (level < 0) {
+        return false;
+    }
+
+    out.resize(0);
+    const ImVector<ImVec2>& buckets = p.levels[level];
+    const size_t size = p.BucketSize(level);
+    float xs[block_size];
+    float ys[block_size];
+    ImVec2 pts[block_size];
+    size_t n = 0;
+    for (size_t j = first / size; j <= (last - 1) / size; j++) {
+        // each bucket becomes a vertical line at its center sample
+        const float x = sample_x(values, ImMin(j * size + size / 2, p.count - 1));
+        const ImVec2& bucket = buckets[static_cast<int>(j)];
+        xs[n] = x; ys[n++] = bucket.x;
+        xs[n] = x; ys[n++] = bucket.y;
+        if (n == block_size) {
+            map.map(map.tf, xs, ys, n, pts);
+            for (size_t k = 0; k < n; k++) out.push_back(pts[k]);
+            n = 0;
+        }
+    }
+    map.map(map.tf, xs, ys, n, pts);
+    for (size_t k = 0; k < n; k++) out.push_back(pts[k]);
+    return true;
+}
+
+// Widens [*min, *max] to the samples [first, last) using whole buckets of the
+// pyramid where possible, only the partial buckets at both ends are read
+static void lod_min_max(const LodPyramid& p, const SeriesMapper& map, size_t first, size_t last, float* min, float* max) {
+    size_t b0 = (first + p.base - 1) / p.base;
+    size_t b1 = last / p.base;
+    if (b0 >= b1) {
+        series_min_max(map, first, last, min, max);
+        return;
+    }
+    series_min_max(map, first, b0 * p.base, min, max);
+    series_min_max(map, b1 * p.base, last, min, max);
+    auto merge = [&](const ImVec2& bucket) {
+        if (bucket.x < *min) *min = bucket.x;
+        if (bucket.y > *max) *max = bucket.y;
+    };
+    // [b0, b1) only holds full buckets, so its aligned middle can be taken from the level above
+    for (int l = 0; l < p.level_count && b0 < b1; l++) {
+        const ImVector<ImVec2>& level = p.levels[l];
+        if (l + 1 == p.level_count) {
+            while (b0 < b1) merge(level[static_cast<int>(b0++)]);
+            break;
+        }
+        while (b0 < b1 && b0 % lod_fanout) merge(level[static_cast<int>(b0++)]);
+        while (b1 > b0 && b1 % lod_fanout) merge(level[static_cast<int>(--b1)]);
+        b0 /= lod_fanout;
+        b1 /= lod_fanout;
+    }
+}
+
+// Everything the series geometry depends on besides the sample values
+struct GeometryKey {
+    uint64_t generation;
+    ImRect bb;
+    float x_min, x_max;
+    float y_min, y_max;
+    PlotConfig::Scale::Type scale;
+    PlotConfig::Scale::Type scale_y;
+    size_t first, last;
+    size_t ys_count;
+    float thickness;
+    ImU32 col;
+    ImGuiID colors; // hash of the series colors
+    PlotConfig::Markers::Shape marker;
+    float marker_size;
+    bool marker_lines;
+    PlotConfig::Decimation decimation;
+    bool skip_small_lines;
+    bool lod_cache;
+    bool lod_submit;
+    size_t lod_memory_budget;
+    const ImVec2* const* lod_summaries;
+    size_t lod_summary_bucket;
+
+    bool operator==(const GeometryKey& o) const {
+        return generation == o.generation && bb.Min == o.bb.Min && bb.Max == o.bb.Max &&
+            x_min == o.x_min && x_max == o.x_max && y_min == o.y_min && y_max == o.y_max &&
+            scale == o.scale && scale_y == o.scale_y && first == o.first && last == o.last && ys_count == o.ys_count &&
+            thickness == o.thickness && col == o.col && colors == o.colors &&
+            marker == o.marker && marker_size == o.marker_size && marker_lines == o.marker_lines &&
+            decimation == o.decimation && skip_small_lines == o.skip_small_lines &&
+            lod_cache == o.lod_cache && lod_submit == o.lod_submit && lod_memory_budget == o.lod_memory_budget &&
+            lod_summaries == o.lod_summaries && lod_summary_bucket == o.lod_summary_bucket;
+    }
+};
+
+// Series geometry of the last frame, indices relative to the first vertex
+struct GeometryCache {
+    bool valid = false;
+    GeometryKey key;
+    ImVector<ImDrawVert> vtx;
+    ImVector<ImDrawIdx> idx;
+
+    // Copies what was appended to draw_list since the given buffer sizes.
+    // Geometry spread over several draw commands isn't cached.
+    void Capture(const ImDrawList* draw_list, int cmd_count, int vtx_start, int idx_start, unsigned int vtx_base) {
+        valid = draw_list->CmdBuffer.Size == cmd_count;
+        if (!valid) return;
+        vtx.resize(draw_list->VtxBuffer.Size - vtx_start);
+        idx.resize(draw_list->IdxBuffer.Size - idx_start);
+        if (vtx.Size) memcpy(vtx.Data, draw_list->VtxBuffer.Data + vtx_start, vtx.Size * sizeof(ImDrawVert));
+        for (int i = 0; i < idx.Size; i++) {
+            idx[i] = static_cast<ImDrawIdx>(draw_list->IdxBuffer[idx_start + i] - vtx_base);
+        }
+    }
+
+    void Replay(ImDrawList* draw_list) const {
+        if (idx.Size == 0) return;
+        draw_list->PrimReserve(idx.Size, vtx.Size);
+        const unsigned int base = draw_list->_VtxCurrentIdx;
+        memcpy(draw_list->_VtxWritePtr, vtx.Data, vtx.Size * sizeof(ImDrawVert));
+        if (base == 0) {
+            memcpy(draw_list->_IdxWritePtr, idx.Data, idx.Size * sizeof(ImDrawIdx));
+        }
+        else {
+            for (int i = 0; i < idx.Size; i++) {
+                draw_list->_IdxWritePtr[i] = static_cast<ImDrawIdx>(idx[i] + base);
+            }
+        }
+        draw_list->_VtxWritePtr += vtx.Size;
+        draw_list->_IdxWritePtr += idx.Size;
+        draw_list->_VtxCurrentIdx += vtx.Size;
+    }
+};
+
+// Screen positions of the samples of one series that were drawn so far,
+// kept for append_only plots. Valid while the transform stays the same.
+struct PointCache {
+    PlotConfig::Buffer xs;
+    PlotConfig::Buffer ys;
+    MapFn map = nullptr;
+    ScreenTransform tf;
+    size_t first = 0;
+    size_t last = 0; // samples [first, last) have been processed
+    bool skip_small_lines = false;
+    PointBuffer points;
+
+    bool Matches(const SeriesMapper& map, size_t _first, bool _skip_small_lines) const {
+        return same_buffer(xs, map.xs) && same_buffer(ys, map.ys) && this->map == map.map && first == _first &&
+            skip_small_lines == _skip_small_lines &&
+            tf.bb.Min == map.tf.bb.Min && tf.bb.Max == map.tf.bb.Max && tf.x_min == map.tf.x_min &&
+            tf.y_min == map.tf.y_min && tf.x_inv_min == map.tf.x_inv_min && tf.y_inv_min == map.tf.y_inv_min &&
+            tf.kx == map.tf.kx && tf.ky == map.tf.ky;
+    }
+};
+
+// Formatted major tick labels of one axis and their sizes, kept between
+// frames so that labels are only formatted and measured when they change
+struct AxisLabels {
+    // what the labels were made for
+    float min = 0;
+    float max = 0;
+    float tick_distance = 0;
+    unsigned int tick_subs = 0;
+    ImGuiID format_hash = 0;
+    PlotConfig::Scale::Type scale = PlotConfig::Scale::Type::Linear;
+    const ImFont* font = nullptr;
+    float font_size = 0;
+    bool valid = false;
+
+    ImVec2 largest;
+    ImVector<ImVec2> sizes;
+    ImVector<int> offsets; // start of every label in text
+    ImVector<char> text;
+
+    // Returns true if the labels are up to date, otherwise clears them
+    bool Sync(const PlotConfig::Axis& axis, float _min, float _max, PlotConfig::Scale::Type _scale) {
+        ImGuiContext& g = *GImGui;
+        const ImGuiID hash = ImHashStr(axis.label_format);
+        if (valid && min == _min && max == _max && tick_distance == axis.tick_distance && tick_subs == axis.tick_subs &&
+            format_hash == hash && scale == _scale && font == g.Font && font_size == g.FontSize) {
+            return true;
+        }
+        min = _min;
+        max = _max;
+        tick_distance = axis.tick_distance;
+        tick_subs = axis.tick_subs;
+        format_hash = hash;
+        scale = _scale;
+        font = g.Font;
+        font_size = g.FontSize;
+        valid = true;
+        largest = ImVec2(.0f, .0f);
+        sizes.resize(0);
+        offsets.resize(0);
+        text.resize(0);
+        return false;
+    }
+
+    void Add(const char* format, float value) {
+        ImGuiContext& g = *GImGui;
+        const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), format, value);
+        const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
+        if (text_size.x > largest.x) { largest.x = text_size.x; }
+        if (text_size.y > largest.y) { largest.y = text_size.y; }
+        sizes.push_back(text_size);
+        offsets.push_back(text.Size);
+        for (const char* c = g.TempBuffer; c != text_end; c++) text.push_back(*c);
+    }
+
+    int Size() const { return offsets.Size; }
+    const char* Text(int i) const { return text.Data + offsets[i]; }
+    const char* TextEnd(int i) const { return text.Data + (i + 1 < offsets.Size ? offsets[i + 1] : text.Size); }
+};
+
+// y range of the samples of one series, for Scale::auto_fit
+struct RangeCache {
+    PlotConfig::Buffer ys;
+    uint64_t generation = 0;
+    size_t first = 0;
+    size_t last = 0;
+    float min = 0;
+    float max = 0;
+};
+
+// PlotStats counters of one series
+struct SeriesStats {
+    size_t samples = 0;
+    size_t skipped = 0; // by skip_small_lines
+};
+
+// Line points of one series built by a PlotConfig::Parallel worker
+struct SeriesPoints {
+    PointBuffer points;
+    PointBuffer decimated;
+    SeriesStats stats;
+    bool complete = true;
+    // acquired on the calling thread with LevelOfDetail::submit
+    const LodPyramid* lod = nullptr;
+    bool lod_pending = false;
+};
+
+// Data kept between frames for one plot
+struct PlotState {
+    ImGuiContext* context = nullptr;
+    ImGuiID id = 0;
+    ImGuiID key = 0; // plot_state_key(context, id)
+    int last_frame = 0; // last frame a plot asked for it
+    ImVector<LodPyramid*> lods; // one per series
+    ImVector<LodBuild*> builds; // one per series, null unless a build is pending
+    ImVector<PointCache*> points; // one per series
+    ImVector<RangeCache> ranges; // one per series
+    ImVector<SeriesPoints*> series; // one per series, for PlotConfig::Parallel
+    GeometryCache geometry;
+    AxisLabels labels_x;
+    AxisLabels labels_y;
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    PlotStats stats; // last collected ones
+    bool has_stats = false;
+#endif
+
+    ~PlotState() {
+        for (int i = 0; i < lods.Size; i++) IM_DELETE(lods[i]);
+        for (int i = 0; i < builds.Size; i++) {
+            if (builds[i]) lod_release(builds[i]);
+        }
+        for (int i = 0; i < points.Size; i++) IM_DELETE(points[i]);
+        for (int i = 0; i < series.Size; i++) IM_DELETE(series[i]);
+    }
+
+    LodPyramid& Lod(int series) {
+        while (lods.Size <= series) lods.push_back(IM_NEW(LodPyramid)());
+        return *lods[series];
+    }
+
+    LodBuild*& Build(int series) {
+        while (builds.Size <= series) builds.push_back(nullptr);
+        return builds[series];
+    }
+
+    PointCache& Points(int series) {
+        while (points.Size <= series) points.push_back(IM_NEW(PointCache)());
+        return *points[series];
+    }
+
+    SeriesPoints& Series(int i) {
+        while (series.Size <= i) series.push_back(IM_NEW(SeriesPoints)());
+        return *series[i];
+    }
+
+    RangeCache& Range(int series) {
+        while (ranges.Size <= series) ranges.push_back(RangeCache());
+        return ranges[series];
+    }
+};
+
+// Plot states of all contexts, sorted by key. A state is freed when no plot
+// asked for it in plot_state_gc_frames frames, when its context is destroyed
+// or by PlotInvalidateCache(), and leaves nothing behind.
+static const int plot_state_gc_frames = 600;
+static ImVector<PlotState*> plot_states;
+static ImVector<ImGuiContext*> plot_state_contexts; // the ones with hooks installed
+
+static ImGuiID plot_state_key(ImGuiContext* context, ImGuiID id) {
+    return ImHashData(&context, sizeof(context), id);
+}
+
+// Index of the first state whose key isn't below key
+static int plot_state_lower_bound(ImGuiID key) {
+    int lo = 0, hi = plot_states.Size;
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (plot_states[mid]->key < key) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+static void free_plot_state(int i) {
+    IM_DELETE(plot_states[i]);
+    plot_states.erase(plot_states.Data + i);
+}
+
+static void plot_state_gc_hook(ImGuiContext* context, ImGuiContextHook*) {
+    lod_collect();
+    for (int i = plot_states.Size - 1; i >= 0; i--) {
+        if (plot_states[i]->context == context && context->FrameCount - plot_states[i]->last_frame > plot_state_gc_frames) {
+            free_plot_state(i);
+        }
+    }
+}
+
+static void plot_state_shutdown_hook(ImGuiContext* context, ImGuiContextHook*) {
+    for (int i = plot_states.Size - 1; i >= 0; i--) {
+        if (plot_states[i]->context == context) free_plot_state(i);
+    }
+    plot_state_contexts.find_erase(context);
+}
+
+static PlotState* find_plot_state(ImGuiID id) {
+    ImGuiContext* context = GImGui;
+    const ImGuiID key = plot_state_key(context, id);
+    const int i = plot_state_lower_bound(key);
+    PlotState* state = i < plot_states.Size && plot_states[i]->key == key ? plot_states[i] : nullptr;
+    return state && state->context == context && state->id == id ? state : nullptr;
+}
+
+static PlotState& get_plot_state(ImGuiID id) {
+    ImGuiContext* context = GImGui;
+    PlotState* state = find_plot_state(id);
+    if (!state) {
+        if (!plot_state_contexts.contains(context)) {
+            ImGuiContextHook hook;
+            hook.Type = ImGuiContextHookType_NewFramePre;
+            hook.Callback = plot_state_gc_hook;
+            AddContextHook(context, &hook);
+            hook.Type = ImGuiContextHookType_Shutdown;
+            hook.Callback = plot_state_shutdown_hook;
+            AddContextHook(context, &hook);
+            plot_state_contexts.push_back(context);
+        }
+        // a hash collision replaces the other state
+        const ImGuiID key = plot_state_key(context, id);
+        const int i = plot_state_lower_bound(key);
+        if (i < plot_states.Size && plot_states[i]->key == key) {
+            free_plot_state(i);
+        }
+        state = IM_NEW(PlotState)();
+        state->context = context;
+        state->id = id;
+        state->key = key;
+        plot_states.insert(plot_states.Data + i, state);
+    }
+    state->last_frame = context->FrameCount;
+    return *state;
+}
+
+void PlotInvalidateCache(ImGuiID id) {
+    for (int i = plot_states.Size - 1; i >= 0; i--) {
+        if (id == 0 || (plot_states[i]->context == GImGui && plot_states[i]->id == id)) {
+            free_plot_state(i);
+        }
+    }
+}
+
+float PlotLodProgress(ImGuiID id) {
+    PlotState* state = find_plot_state(id);
+    if (!state) return 1.0f;
+    double done = 0, total = 0;
+    for (int i = 0; i < state->builds.Size; i++) {
+        if (!state->builds[i]) continue;
+        done += static_cast<double>(state->builds[i]->progress.load(std::memory_order_relaxed));
+        total += static_cast<double>(state->builds[i]->count);
+    }
+    return total > 0 ? static_cast<float>(done / total) : 1.0f;
+}
+
+bool PlotLodBuilding() {
+    return lod_jobs_running.load(std::memory_order_acquire) > 0;
+}
+
+// What the pyramid of series i has to be built from
+static LodKey lod_key(const PlotConfig& conf, const PlotConfig::Buffer& ys, int i, size_t ys_count) {
+    LodKey key;
+    key.source = ys;
+    IM_ASSERT((!conf.lod.summaries || conf.lod.summary_bucket > 0) && "LevelOfDetail::summaries need a summary_bucket");
+    // without a bucket size the summaries can't be used, the samples are read instead
+    if (conf.lod.summaries && conf.lod.summaries[i] && conf.lod.summary_bucket > 0) {
+        key.summary = conf.lod.summaries[i];
+        key.summary_bucket = conf.lod.summary_bucket;
+    }
+    key.generation = conf.generation;
+    key.base = lod_base_for(conf.values.count, conf.lod.memory_budget / ys_count, key.summary ? key.summary_bucket : 8);
+    return key;
+}
+
+// Pyramid of series i to draw this frame, or null if there is none yet.
+// With LevelOfDetail::submit, pyramids that need a rebuild are built in the
+// background and *pending is set, meanwhile the previous one is used if it
+// is of the same buffer and reaches up to last.
+static const LodPyramid* lod_acquire(PlotState& state, int i, const SeriesMapper& map, const PlotConfig& conf, size_t ys_count,
+    size_t last, bool* pending) {
+    *pending = false;
+    LodPyramid& p = state.Lod(i);
+    const size_t count = conf.values.count;
+    const LodKey key = lod_key(conf, map.ys, i, ys_count);
+    if (!conf.lod.submit) {
+        lod_sync(p, map, key, count, conf.append_only);
+        return &p;
+    }
+
+    LodBuild*& build = state.Build(i);
+    if (build && build->done.load(std::memory_order_acquire)) {
+        // the old pyramid goes away with the build
+        p.Swap(build->pyramid);
+        lod_release(build);
+        build = nullptr;
+    }
+    if (lod_extends(p, p.count, key, count, conf.append_only)) {
+        if (build) {
+            lod_release(build);
+            build = nullptr;
+        }
+        // appended samples are cheap enough to add right away
+        if (count > p.count) lod_update(p, map, count, p.count);
+        return &p;
+    }
+    if (build && !lod_extends(build->pyramid, build->count, key, count, conf.append_only)) {
+        lod_release(build);
+        build = nullptr;
+    }
+    lod_collect();
+    if (!build) {
+        build = IM_NEW(LodBuild)();
+        static_cast<LodKey&>(build->pyramid) = key;
+        lod_reserve(build->pyramid, key.base, count);
+        build->map = map;
+        build->map.visited = nullptr; // the job outlives this frame's counters
+        build->count = count;
+        lod_jobs_running.fetch_add(1, std::memory_order_relaxed);
+        conf.lod.submit(lod_build_job, build, conf.lod.user_data);
+    }
+    *pending = true;
+    return same_buffer(p.source, map.ys) && p.count >= last ? &p : nullptr;
+}
+
+// Collects the points of a series into contiguous runs and hands every run
+// to the draw list in one call. Runs only break where a segment leaves the
+// clip rect, at points that aren't finite, or when they get long enough to
+// overflow 16-bit draw indices.
+struct PolylineBuilder {
+    static const int max_run = 8192;
+
+    ImDrawList* draw_list;
+    ImRect clip;
+    ImU32 col;
+    float thickness;
+    ImVector<ImVec2>* run;
+    ImVec2 last;
+    bool has_last;
+    size_t emitted;
+    size_t clipped;
+
+    void Add(const ImVec2& p) {
+        // samples a Log10 axis can't show, the line restarts after them
+        if (!is_finite(p)) {
+            Flush();
+            has_last = false;
+            return;
+        }
+        if (has_last) {
+            if (clip.Contains(last) || clip.Contains(p)) {
+                if (run->Size == 0) run->push_back(last);
+                run->push_back(p);
+                IMGUI_PLOT_STAT(emitted++);
+                if (run->Size >= max_run) Flush();
+            }
+            else {
+                IMGUI_PLOT_STAT(clipped++);
+                Flush();
+            }
+        }
+        last = p;
+        has_last = true;
+    }
+
+    void Flush() {
+        if (run->Size >= 2) {
+            draw_list->AddPolyline(run->Data, run->Size, col, 0, thickness);
+        }
+        run->resize(0);
+    }
+};
+
+// Triangles of one marker around (0, 0), moved to every point
+struct MarkerShape {
+    ImVector<ImVec2> vtx;
+    ImVector<ImDrawIdx> idx;
+
+    void AddQuad(const ImVec2& a, const ImVec2& b, const ImVec2& c, const ImVec2& d) {
+        const ImDrawIdx base = static_cast<ImDrawIdx>(vtx.Size);
+        vtx.push_back(a); vtx.push_back(b); vtx.push_back(c); vtx.push_back(d);
+        const ImDrawIdx quad[] = { 0, 1, 2, 0, 2, 3 };
+        for (int i = 0; i < 6; i++) idx.push_back(static_cast<ImDrawIdx>(base + quad[i]));
+    }
+};
+
+static void make_marker(PlotConfig::Markers::Shape shape, float size, MarkerShape& out) {
+    out.vtx.resize(0);
+    out.idx.resize(0);
+    const float r = size * 0.5f;
+    switch (shape) {
+    case PlotConfig::Markers::Shape::None:
+        break;
+    case PlotConfig::Markers::Shape::Circle: {
+        // small circles don't need many segments to look round
+        const int segments = ImClamp(static_cast<int>(size), 6, 32);
+        for (int i = 0; i < segments; i++) {
+            const float a = 2.0f * IM_PI * i / segments;
+            out.vtx.push_back(ImVec2(cosf(a) * r, sinf(a) * r));
+        }
+        for (int i = 1; i + 1 < segments; i++) {
+            out.idx.push_back(0);
+            out.idx.push_back(static_cast<ImDrawIdx>(i));
+            out.idx.push_back(static_cast<ImDrawIdx>(i + 1));
+        }
+        break;
+    }
+    case PlotConfig::Markers::Shape::Square:
+        out.AddQuad(ImVec2(-r, -r), ImVec2(r, -r), ImVec2(r, r), ImVec2(-r, r));
+        break;
+    case PlotConfig::Markers::Shape::Cross: {
+        const float t = ImMax(1.0f, size * 0.25f) * 0.5f;
+        out.AddQuad(ImVec2(-r, -t), ImVec2(r, -t), ImVec2(r, t), ImVec2(-r, t));
+        out.AddQuad(ImVec2(-t, -r), ImVec2(t, -r), ImVec2(t, r), ImVec2(-t, r));
+        break;
+    }
+    case PlotConfig::Markers::Shape::Triangle:
+        out.vtx.push_back(ImVec2(0.0f, -r));
+        out.vtx.push_back(ImVec2(r * 0.866f, r * 0.5f));
+        out.vtx.push_back(ImVec2(-r * 0.866f, r * 0.5f));
+        out.idx.push_back(0);
+        out.idx.push_back(1);
+        out.idx.push_back(2);
+        break;
+    }
+}
+
+// Collects the markers of one series, keeping one per pixel of the plot
+// rect, and writes them all into one reserved block of the draw list
+struct MarkerBuilder {
+    ImDrawList* draw_list;
+    ImRect clip; // grown by the marker size
+    ImVec2 origin;
+    int width, height;
+    ImU32 col;
+    const MarkerShape* shape;
+    ImVector<ImVec2>* points;
+    ImVector<ImU32>* taken; // one bit per pixel, all clear between series
+    size_t emitted;
+    size_t clipped;
+    size_t merged;
+
+    void Begin() {
+        const int words = (width * height + 31) / 32;
+        if (taken->Size < words) {
+            taken->resize(words);
+            memset(taken->Data, 0, taken->size_in_bytes());
+        }
+    }
+
+    bool Pixel(const ImVec2& p, size_t* bit) const {
+        const int x = static_cast<int>(p.x - origin.x);
+        const int y = static_cast<int>(p.y - origin.y);
+        if (p.x < origin.x || p.y < origin.y || x >= width || y >= height) return false;
+        *bit = static_cast<size_t>(y) * width + x;
+        return true;
+    }
+
+    void Add(const ImVec2& p) {
+        if (!clip.Contains(p)) {
+            IMGUI_PLOT_STAT(clipped++);
+            return;
+        }
+        size_t bit;
+        if (Pixel(p, &bit)) {
+            ImU32& word = (*taken)[static_cast<int>(bit >> 5)];
+            const ImU32 mask = 1u << (bit & 31);
+            if (word & mask) {
+                IMGUI_PLOT_STAT(merged++);
+                return;
+            }
+            word |= mask;
+        }
+        points->push_back(p);
+    }
+
+    void Flush() {
+        const int vtx_count = shape->vtx.Size, idx_count = shape->idx.Size;
+        const ImVec2 uv = draw_list->_Data->TexUvWhitePixel;
+        // 16-bit indices can't address more than 64k vertices per reservation
+        const int chunk = sizeof(ImDrawIdx) == 2 ? 0xFFFF / vtx_count : points->Size;
+        for (int start = 0; start < points->Size; start += chunk) {
+            const int n = ImMin(chunk, points->Size - start);
+            draw_list->PrimReserve(n * idx_count, n * vtx_count);
+            for (int k = start; k < start + n; k++) {
+                const ImVec2 p = (*points)[k];
+                const unsigned int base = draw_list->_VtxCurrentIdx;
+                for (int j = 0; j < idx_count; j++) {
+                    draw_list->PrimWriteIdx(static_cast<ImDrawIdx>(base + shape->idx[j]));
+                }
+                for (int j = 0; j < vtx_count; j++) {
+                    draw_list->PrimWriteVtx(p + shape->vtx[j], uv, col);
+                }
+            }
+        }
+        // clear the bits of this series, which is cheaper than the whole rect
+        IMGUI_PLOT_STAT(emitted += points->Size);
+        for (int k = 0; k < points->Size; k++) {
+            size_t bit;
+            if (Pixel((*points)[k], &bit)) (*taken)[static_cast<int>(bit >> 5)] &= ~(1u << (bit & 31));
+        }
+        points->resize(0);
+    }
+};
+
+// Everything the series of one plot are built from
+struct SeriesContext {
+    const PlotConfig* conf;
+    const PlotConfig::Buffer* ys_list;
+    size_t ys_count;
+    PlotState* state; // set if lod.cache or append_only are used
+    ImRect bb;
+    float x_min, x_max;
+    float y_min, y_max;
+    size_t first, last; // visible samples
+    int columns;
+    bool parallel; // built by PlotConfig::Parallel workers after prepare_series()
+};
+
+// Whether the line of a series is decimated with its LevelOfDetail pyramid
+static bool uses_lod(const PlotConfig& conf, size_t visible, int columns) {
+    return conf.decimation == PlotConfig::Decimation::MinMax && visible > 2 * static_cast<size_t>(columns) &&
+        conf.lod.cache && conf.values.capacity == 0;
+}
+
+// Calls emit(position) for every point of the line of series i. Only the
+// state of that series is touched, so different series can be built at
+// the same time after prepare_series(). Returns false if the line is a
+// placeholder for a pyramid that is still being built.
+template<typename Emit> static bool build_series(const SeriesContext& ctx, int i, PointBuffer& decimated, SeriesStats& stats, Emit emit) {
+    const PlotConfig& conf = *ctx.conf;
+    const size_t first = ctx.first, last = ctx.last;
+    const size_t visible = last - first;
+    SeriesMapper map = make_mapper(conf, ctx.ys_list[i], ctx.bb, ctx.x_min, ctx.x_max, ctx.y_min, ctx.y_max);
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    map.visited = &stats.samples;
+#else
+    IM_UNUSED(stats);
+#endif
+
+    if ((conf.decimation == PlotConfig::Decimation::MinMax && visible > 2 * static_cast<size_t>(ctx.columns)) ||
+        (conf.decimation == PlotConfig::Decimation::LTTB && visible > static_cast<size_t>(ctx.columns) + 2)) {
+        bool pending = false;
+        if (conf.decimation == PlotConfig::Decimation::LTTB) {
+            decimate_lttb(map, first, last, ctx.columns, decimated);
+        }
+        else if (!uses_lod(conf, visible, ctx.columns)) {
+            decimate_min_max(map, first, last, decimated);
+        }
+        else {
+            const LodPyramid* lod;
+            if (ctx.parallel && conf.lod.submit) {
+                const SeriesPoints& series = ctx.state->Series(i);
+                lod = series.lod;
+                pending = series.lod_pending;
+            }
+            else {
+                lod = lod_acquire(*ctx.state, i, map, conf, ctx.ys_count, last, &pending);
+            }
+            if (!lod)
+                decimate_stride(map, first, last, ctx.columns, decimated);
+            else if (!decimate_lod(*lod, conf.values, map, first, last, ctx.columns, decimated))
+                decimate_min_max(map, first, last, decimated);
+        }
+        for (int n = 0; n < decimated.Size; n++) {
+            emit(decimated[n]);
+        }
+        return !pending;
+    }
+
+    if (conf.append_only && conf.values.capacity == 0) {
+        // only transform the samples added since the last frame
+        PointCache& cache = ctx.state->Points(i);
+        if (!cache.Matches(map, first, conf.skip_small_lines) || last < cache.last) {
+            cache.xs = map.xs;
+            cache.skip_small_lines = conf.skip_small_lines;
+            cache.ys = map.ys;
+            cache.map = map.map;
+            cache.tf = map.tf;
+            cache.first = first;
+            cache.last = first + 1;
+            cache.points.resize(0);
+            cache.points.push_back(map(first));
+        }
+        ImVec2 pos0 = cache.points.back();
+        map.ForEach(cache.last, last, [&](size_t, const ImVec2& pos1) {
+            if (!conf.skip_small_lines || ImLengthSqr(pos1 - pos0) > 1.0f * 1.0f) {
+                cache.points.push_back(pos1);
+                pos0 = pos1;
+            }
+            else {
+                IMGUI_PLOT_STAT(stats.skipped++);
+            }
+        });
+        cache.last = last;
+        for (int n = 0; n < cache.points.Size; n++) {
+            emit(cache.points[n]);
+        }
+        return true;
+    }
+
+    ImVec2 pos0 = map(first);
+    emit(pos0);
+    map.ForEach(first + 1, last, [&](size_t, const ImVec2& pos1) {
+        if (!conf.skip_small_lines || ImLengthSqr(pos1 - pos0) > 1.0f * 1.0f) {
+            emit(pos1);
+            pos0 = pos1;
+        }
+        else {
+            IMGUI_PLOT_STAT(stats.skipped++);
+        }
+    });
+    return true;
+}
+
+// Does everything for PlotConfig::Parallel workers that may allocate
+// through ImGui: creates the state of every series, starts or picks up the
+// background pyramid builds and reserves the levels of the pyramids the
+// workers build themselves. The point buffers use malloc.
+static void prepare_series(const SeriesContext& ctx) {
+    PlotState& state = *ctx.state;
+    const PlotConfig& conf = *ctx.conf;
+    const int count = static_cast<int>(ctx.ys_count);
+    state.Lod(count - 1);
+    state.Build(count - 1);
+    state.Points(count - 1);
+    state.Series(count - 1);
+    const bool lod = uses_lod(conf, ctx.last - ctx.first, ctx.columns);
+    for (int i = 0; i < count; i++) {
+        SeriesPoints& series = state.Series(i);
+        series.lod = nullptr;
+        series.lod_pending = false;
+        if (!lod) continue;
+        if (conf.lod.submit) {
+            const SeriesMapper map = make_mapper(conf, ctx.ys_list[i], ctx.bb, ctx.x_min, ctx.x_max, ctx.y_min, ctx.y_max);
+            series.lod = lod_acquire(state, i, map, conf, ctx.ys_count, ctx.last, &series.lod_pending);
+        }
+        else {
+            lod_reserve(state.Lod(i), lod_key(conf, ctx.ys_list[i], i, ctx.ys_count).base, conf.values.count);
+        }
+    }
+}
+
+// PlotConfig::Parallel task, builds series i into its point buffer
+static void build_series_task(size_t i, void* data) {
+    const SeriesContext& ctx = *static_cast<const SeriesContext*>(data);
+    SeriesPoints& series = ctx.state->Series(static_cast<int>(i));
+    series.points.resize(0);
+    series.stats = SeriesStats();
+    series.complete = build_series(ctx, static_cast<int>(i), series.decimated, series.stats,
+        [&](const ImVec2& p) { series.points.push_back(p); });
+}
+
+#ifndef IMGUI_PLOT_DISABLE_STATS
+typedef std::chrono::steady_clock StatClock;
+
+// Adds the time since the previous lap to a PlotStats section
+struct StatStopwatch {
+    StatClock::time_point last = StatClock::now();
+
+    void Lap(double* section) {
+        const StatClock::time_point now = StatClock::now();
+        *section += std::chrono::duration<double>(now - last).count();
+        last = now;
+    }
+};
+#endif
+
+static PlotStatus plot_impl(const char* label, const PlotConfig& conf, PlotStats* stats) {
     PlotStatus status = PlotStatus::nothing;
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    StatStopwatch watch;
+#else
+    IM_UNUSED(stats);
+#endif
 
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -123,13 +1893,69 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
         {
             auto min = 0;
             auto max = conf.values.count - 1;
-            if (conf.values.xs.IsNullptr()) {
-                x_min = static_cast<float>(min);
-                x_max = static_cast<float>(max);
+            x_min = sample_x(conf.values, min);
+            x_max = sample_x(conf.values, max);
+        }
+        const float data_x_min = x_min;
+        const float data_x_max = x_max;
+        if (conf.view.x_min && conf.view.x_max && *conf.view.x_min != *conf.view.x_max) {
+            x_min = *conf.view.x_min;
+            x_max = *conf.view.x_max;
+        }
+
+        size_t first, last;
+        visible_range(conf.values, x_min, x_max, &first, &last);
+        const size_t visible = last > first ? last - first : 0;
+
+        // y range, either given or fitted to the visible samples
+        float y_min = conf.scale.min;
+        float y_max = conf.scale.max;
+        if (conf.scale.auto_fit && visible > 0) {
+            PlotState& state = get_plot_state(id);
+            float lo = FLT_MAX, hi = -FLT_MAX;
+            for (int i = 0; i < ys_count; ++i) {
+                // only used to load samples, so the y transform doesn't matter
+                SeriesMapper map = make_mapper(conf, ys_list[i], frame_bb, x_min, x_max, 0.0f, 1.0f);
+                IMGUI_PLOT_STAT(if (stats) map.visited = &stats->samples_visited);
+                RangeCache& range = state.Range(i);
+                const bool same = same_buffer(range.ys, map.ys) && range.first == first && conf.values.capacity == 0;
+                bool exact = true;
+                if (same && conf.generation != 0 && range.generation == conf.generation && range.last == last) {
+                    // samples didn't change
+                }
+                else if (same && conf.append_only && last >= range.last) {
+                    series_min_max(map, range.last, last, &range.min, &range.max);
+                }
+                else {
+                    range.min = FLT_MAX;
+                    range.max = -FLT_MAX;
+                    const bool use_lod = conf.lod.cache && conf.values.capacity == 0;
+                    bool pending = false;
+                    const LodPyramid* lod = use_lod ? lod_acquire(state, i, map, conf, ys_count, last, &pending) : nullptr;
+                    // look again next frame while the pyramid is being built
+                    exact = !pending;
+                    if (lod) {
+                        lod_min_max(*lod, map, first, last, &range.min, &range.max);
+                    }
+                    else if (use_lod) {
+                        series_min_max_sampled(map, first, last, 4096, &range.min, &range.max);
+                    }
+                    else {
+                        series_min_max(map, first, last, &range.min, &range.max);
+                    }
+                }
+                range.ys = exact ? map.ys : PlotConfig::Buffer();
+                range.generation = conf.generation;
+                range.first = first;
+                range.last = last;
+                lo = ImMin(lo, range.min);
+                hi = ImMax(hi, range.max);
             }
-            else {
-                x_min = conf.values.xs[min];
-                x_max = conf.values.xs[max];
+            // all samples NaN
+            if (lo <= hi) {
+                y_min = lo;
+                y_max = hi;
+                fit_range(conf.scale, &y_min, &y_max);
             }
         }
 
@@ -140,8 +1966,14 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
             float tick_first = .0f;
         } axis_info_x, axis_info_y;
 
-        // Precalculate basic axis parameters since the plot area depends on text widths
-        if (conf.axis_x.grid_show || conf.axis_x.label_show_bl || conf.axis_x.label_show_tr) {
+        // Precalculate basic axis parameters since the plot area depends on text widths.
+        // Labels are only formatted and measured again when the axis changes.
+        const bool labels_x = conf.axis_x.label_show_bl || conf.axis_x.label_show_tr;
+        const bool labels_y = conf.axis_y.label_show_bl || conf.axis_y.label_show_tr;
+        PlotState* label_state = (labels_x || labels_y) ? &get_plot_state(id) : nullptr;
+        if (conf.axis_x.grid_show || labels_x) {
+            AxisLabels* labels = labels_x ? &label_state->labels_x : nullptr;
+            const bool cached = labels && labels->Sync(conf.axis_x, x_min, x_max, conf.scale.type);
             switch (conf.scale.type) {
             case PlotConfig::Scale::Type::Linear: {
                 axis_info_x.tick_count = (x_max - x_min) / (conf.axis_x.tick_distance / (conf.axis_x.tick_subs + 1));
@@ -149,50 +1981,66 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
                 // calculate nearest multiple of tick_distance to x_min and do inverse lerp:
                 axis_info_x.tick_first = lerp_inv(x_min, x_max, (static_cast<int>(x_min / conf.axis_x.tick_distance)* conf.axis_x.tick_distance));
                 axis_info_x.tick_count += conf.axis_x.tick_subs + 1;
-                if (!conf.axis_x.label_show_bl && !conf.axis_x.label_show_tr) { break; }
+                if (!labels || cached) { break; }
                 for (int i = 0; i <= axis_info_x.tick_count; i += conf.axis_x.tick_subs + 1) {
                     const float tick_pos = axis_info_x.tick_first + i * axis_info_x.tick_inc;
                     if (tick_pos < 0.0f) continue;
                     if (tick_pos > 1.0f) break;
-                    const float x_val = ImLerp(x_min, x_max, tick_pos);
-                    const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_x.label_format, x_val);
-                    const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
-                    if (text_size.x > axis_info_x.legend_largest.x) { axis_info_x.legend_largest.x = text_size.x; }
-                    if (text_size.y > axis_info_x.legend_largest.y) { axis_info_x.legend_largest.y = text_size.y; }
+                    labels->Add(conf.axis_x.label_format, ImLerp(x_min, x_max, tick_pos));
                 }
                 break;
             }
             case PlotConfig::Scale::Type::Log10: {
-                if (!conf.axis_x.label_show_bl && !conf.axis_x.label_show_tr) { break; }
+                if (!labels || cached) { break; }
                 for (float i = 1; i <= x_max; i *= 10)
                 {
                     if (i < x_min) continue;
-                    const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_x.label_format, i);
-                    const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
-                    if (text_size.x > axis_info_x.legend_largest.x) { axis_info_x.legend_largest.x = text_size.x; }
-                    if (text_size.y > axis_info_x.legend_largest.y) { axis_info_x.legend_largest.y = text_size.y; }
+                    labels->Add(conf.axis_x.label_format, i);
                 }
                 break;
             }
             }
+            if (labels) axis_info_x.legend_largest = labels->largest;
         }
-        if (conf.axis_y.grid_show || conf.axis_y.label_show_tr || conf.axis_y.label_show_bl) {
-            axis_info_y.tick_count = (conf.scale.max - conf.scale.min) / (conf.axis_y.tick_distance / (conf.axis_y.tick_subs + 1));
-            axis_info_y.tick_inc = 1.f / axis_info_y.tick_count;
-            axis_info_y.tick_first = lerp_inv(conf.scale.min, conf.scale.max, (static_cast<int>(conf.scale.min / conf.axis_y.tick_distance)* conf.axis_y.tick_distance));
-            axis_info_y.tick_count += conf.axis_y.tick_subs + 1;
-            if (conf.axis_y.label_show_bl || conf.axis_y.label_show_tr) {
-                for (int i = 0; i <= axis_info_y.tick_count; i += conf.axis_y.tick_subs + 1) {
-                    const float tick_pos = axis_info_y.tick_first + i * axis_info_y.tick_inc;
-                    if (tick_pos < 0.0f) continue;
-                    if (tick_pos > 1.0f) break;
-                    // Todo make this position properly
-                    const float y_val = ImLerp(conf.scale.min, conf.scale.max, tick_pos);
-                    const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_y.label_format, y_val);
-                    const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
-                    if (text_size.x > axis_info_y.legend_largest.x) { axis_info_y.legend_largest.x = text_size.x; }
-                    if (text_size.y > axis_info_y.legend_largest.y) { axis_info_y.legend_largest.y = text_size.y; }
+        // Log10 y-axes get a line at every 1..9 multiple of a power of ten, labeled at the powers
+        const bool log_y = conf.scale.type_y == PlotConfig::Scale::Type::Log10;
+        if (log_y) {
+            IM_ASSERT(y_min > 0.0f && y_max > 0.0f && "Log10 y-axes need scale.min and scale.max > 0");
+            // the decades below would be INT_MIN otherwise, and the loops over them endless
+            if (!(y_max > 0.0f && y_max <= FLT_MAX)) y_max = 10.0f;
+            if (!(y_min > 0.0f && y_min <= FLT_MAX)) y_min = y_max * 1e-6f;
+        }
+        const int decade_first = log_y ? static_cast<int>(floorf(log10f(y_min))) : 0;
+        const int decade_last = log_y ? static_cast<int>(floorf(log10f(y_max))) : -1;
+        if (conf.axis_y.grid_show || labels_y) {
+            // Log10 ticks come from the decades, y_min / tick_distance may not even fit an int there
+            if (!log_y) {
+                axis_info_y.tick_count = (y_max - y_min) / (conf.axis_y.tick_distance / (conf.axis_y.tick_subs + 1));
+                axis_info_y.tick_inc = 1.f / axis_info_y.tick_count;
+                axis_info_y.tick_first = lerp_inv(y_min, y_max, (static_cast<int>(y_min / conf.axis_y.tick_distance)* conf.axis_y.tick_distance));
+                axis_info_y.tick_count += conf.axis_y.tick_subs + 1;
+            }
+            if (labels_y) {
+                AxisLabels& labels = label_state->labels_y;
+                if (!labels.Sync(conf.axis_y, y_min, y_max, conf.scale.type_y)) {
+                    if (log_y) {
+                        for (int e = decade_first; e <= decade_last; e++) {
+                            const float y_val = powf(10.0f, static_cast<float>(e));
+                            if (y_val < y_min) continue;
+                            labels.Add(conf.axis_y.label_format, y_val);
+                        }
+                    }
+                    else {
+                        for (int i = 0; i <= axis_info_y.tick_count; i += conf.axis_y.tick_subs + 1) {
+                            const float tick_pos = axis_info_y.tick_first + i * axis_info_y.tick_inc;
+                            if (tick_pos < 0.0f) continue;
+                            if (tick_pos > 1.0f) break;
+                            // Todo make this position properly
+                            labels.Add(conf.axis_y.label_format, ImLerp(y_min, y_max, tick_pos));
+                        }
+                    }
                 }
+                axis_info_y.legend_largest = labels.largest;
             }
         }
 
@@ -205,20 +2053,81 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
             return status;
         }
 
+        // The last looked up sample index speeds up the next lookup
+        ImGuiStorage* storage = GetStateStorage();
+        size_t cursor_hint = static_cast<size_t>(storage->GetInt(id, 0));
+        auto cursor_idx = [&]() {
+            cursor_hint = cursor_to_idx(g.IO.MousePos, inner_bb, conf, x_min, x_max, cursor_hint);
+            if (cursor_hint <= INT_MAX) storage->SetInt(id, static_cast<int>(cursor_hint));
+            return cursor_hint;
+        };
+
+        IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_axes));
+
+        // Zoom and pan, takes effect on the next frame
+        if (conf.view.zoom_pan && conf.view.x_min && conf.view.x_max && hovered) {
+            SetItemUsingMouseWheel();
+            // work in scale space so that Log10 zooms evenly
+            const bool log = conf.scale.type == PlotConfig::Scale::Type::Log10;
+            float v0 = log ? log10f(x_min) : x_min;
+            float v1 = log ? log10f(x_max) : x_max;
+            bool changed = false;
+            if (g.IO.MouseWheel != 0.0f) {
+                const float t = ImClamp(lerp_inv(inner_bb.Min.x, inner_bb.Max.x, g.IO.MousePos.x), 0.0f, 1.0f);
+                const float pivot = ImLerp(v0, v1, t);
+                const float zoom = powf(0.8f, g.IO.MouseWheel);
+                v0 = pivot - (pivot - v0) * zoom;
+                v1 = pivot + (v1 - pivot) * zoom;
+                changed = true;
+            }
+            if (g.IO.MouseDown[1] && g.IO.MouseDelta.x != 0.0f) {
+                const float shift = -g.IO.MouseDelta.x / inner_bb.GetWidth() * (v1 - v0);
+                v0 += shift;
+                v1 += shift;
+                changed = true;
+            }
+            if (g.IO.MouseDoubleClicked[1]) {
+                v0 = log ? log10f(data_x_min) : data_x_min;
+                v1 = log ? log10f(data_x_max) : data_x_max;
+                changed = true;
+            }
+            if (changed && v1 > v0) {
+                *conf.view.x_min = log ? powf(10.0f, v0) : v0;
+                *conf.view.x_max = log ? powf(10.0f, v1) : v1;
+                status = PlotStatus::view_updated;
+            }
+        }
+
         // Tooltip on hover
         int v_hovered = -1;
         if (conf.tooltip.show && hovered && inner_bb.Contains(g.IO.MousePos)) {
-            const size_t v_idx = cursor_to_idx(g.IO.MousePos, inner_bb, conf, x_min, x_max);
+            const size_t v_idx = cursor_idx();
             const size_t data_idx = v_idx % conf.values.count;
-            const float x0 = conf.values.xs.IsNullptr() ? v_idx : conf.values.xs[data_idx];
-            const float y0 = ys_list[0][data_idx]; // TODO: tooltip is only shown for the first y-value!
-            SetTooltip(conf.tooltip.format, x0, y0);
+            const float x0 = sample_x(conf.values, data_idx);
+            if (ys_count == 1) {
+                SetTooltip(conf.tooltip.format, x0, sample_y(conf.values, ys_list[0], data_idx));
+            }
+            else {
+                // one line per series, in the series color
+                BeginTooltip();
+                for (size_t i = 0; i < ys_count; ++i) {
+                    const float y0 = sample_y(conf.values, ys_list[i], data_idx);
+                    if (colors && colors[i])
+                        TextColored(ColorConvertU32ToFloat4(colors[i]), conf.tooltip.format, x0, y0);
+                    else
+                        Text(conf.tooltip.format, x0, y0);
+                }
+                EndTooltip();
+            }
             v_hovered = v_idx;
         }
 
-        if (conf.axis_x.grid_show || conf.axis_x.label_show_bl || conf.axis_x.label_show_tr) {
+        IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_interaction));
+
+        if (conf.axis_x.grid_show || labels_x) {
             float y0 = inner_bb.Min.y;
             float y1 = inner_bb.Max.y;
+            int label_idx = 0;
             switch (conf.scale.type) {
             case PlotConfig::Scale::Type::Linear: {
                 for (int i = 0; i <= axis_info_x.tick_count; ++i) {
@@ -233,19 +2142,19 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
                             ImVec2(x0, y1),
                             IM_COL32(200, 200, 200, isSub ? 128 : 255));
                     }
-                    if (!isSub) {
-                        const float x_val = ImLerp(x_min, x_max, tick_pos);
-                        const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_x.label_format, x_val);
-                        const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
+                    if (!isSub && labels_x && label_idx < label_state->labels_x.Size()) {
+                        const AxisLabels& labels = label_state->labels_x;
+                        const ImVec2 text_size = labels.sizes[label_idx];
                         const float text_pos_x = ImClamp(x0 - text_size.x / 2, inner_bb.Min.x, inner_bb.Max.x - text_size.x);
                         if (conf.axis_x.label_show_bl) {
                             // bottom
-                            RenderText(ImVec2(text_pos_x, y1), g.TempBuffer, text_end, false);
+                            RenderText(ImVec2(text_pos_x, y1), labels.Text(label_idx), labels.TextEnd(label_idx), false);
                         }
                         if (conf.axis_x.label_show_tr) {
                             // top
-                            RenderText(ImVec2(text_pos_x, y0 - text_size.y), g.TempBuffer, text_end, false);
+                            RenderText(ImVec2(text_pos_x, y0 - text_size.y), labels.Text(label_idx), labels.TextEnd(label_idx), false);
                         }
+                        label_idx++;
                     }
                 }
                 break;
@@ -266,16 +2175,17 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
                                 ImVec2(x0, y1),
                                 IM_COL32(200, 200, 200, isSub ? 128 : 255));
                         }
-                        if (!isSub && (conf.axis_x.label_show_bl || conf.axis_x.label_show_tr)) {
-                            const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_x.label_format, x);
-                            const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
+                        if (!isSub && labels_x && label_idx < label_state->labels_x.Size()) {
+                            const AxisLabels& labels = label_state->labels_x;
+                            const ImVec2 text_size = labels.sizes[label_idx];
                             const float text_pos_x = ImClamp(x0 - text_size.x / 2, inner_bb.Min.x, inner_bb.Max.x - text_size.x);
                             if (conf.axis_x.label_show_tr) {
-                                RenderText(ImVec2(text_pos_x, y0 - text_size.y), g.TempBuffer, text_end, false);
+                                RenderText(ImVec2(text_pos_x, y0 - text_size.y), labels.Text(label_idx), labels.TextEnd(label_idx), false);
                             }
                             if (conf.axis_x.label_show_bl) {
-                                RenderText(ImVec2(text_pos_x, y1), g.TempBuffer, text_end, false);
+                                RenderText(ImVec2(text_pos_x, y1), labels.Text(label_idx), labels.TextEnd(label_idx), false);
                             }
+                            label_idx++;
                         }
                     }
                 }
@@ -283,14 +2193,11 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
             }
             }
         }
-        if (conf.axis_y.grid_show || conf.axis_y.label_show_tr || conf.axis_y.label_show_bl) {
+        if (conf.axis_y.grid_show || labels_y) {
             float x0 = inner_bb.Min.x;
             float x1 = inner_bb.Max.x;
-            for (int i = 0; i <= axis_info_y.tick_count; ++i) {
-                const float tick_pos = axis_info_y.tick_first + i * axis_info_y.tick_inc;
-                const bool isSub = i % (conf.axis_y.tick_subs + 1);
-                if (tick_pos < 0.0f) continue;
-                if (tick_pos > 1.0f) break;
+            int label_idx = 0;
+            auto draw_tick = [&](float tick_pos, bool isSub) {
                 float y0 = ImLerp(inner_bb.Max.y, inner_bb.Min.y, tick_pos);
                 if (conf.axis_y.grid_show) {
                     window->DrawList->AddLine(
@@ -298,68 +2205,144 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
                         ImVec2(x1, y0),
                         IM_COL32(0, 0, 0, isSub ? 16 : 64));
                 }
-                if (!isSub && (conf.axis_y.label_show_bl || conf.axis_y.label_show_tr)) {
-                    const float y_val = ImLerp(conf.scale.min, conf.scale.max, tick_pos);
-                    const char* text_end = g.TempBuffer + ImFormatString(g.TempBuffer, IM_ARRAYSIZE(g.TempBuffer), conf.axis_y.label_format, y_val);
-                    const ImVec2 text_size = CalcTextSize(g.TempBuffer, text_end);
+                if (!isSub && labels_y && label_idx < label_state->labels_y.Size()) {
+                    const AxisLabels& labels = label_state->labels_y;
+                    const ImVec2 text_size = labels.sizes[label_idx];
                     const float text_pos_y = ImClamp(y0 - text_size.y / 2, inner_bb.Min.y, inner_bb.Max.y - text_size.y);
                     if (conf.axis_y.label_show_bl) {
                         // left
-                        RenderText(ImVec2(x0 - axis_info_y.legend_largest.x, text_pos_y), g.TempBuffer, text_end, false);
+                        RenderText(ImVec2(x0 - axis_info_y.legend_largest.x, text_pos_y), labels.Text(label_idx), labels.TextEnd(label_idx), false);
                     }
                     if (conf.axis_y.label_show_tr) {
                         // right
-                        RenderText(ImVec2(x1, text_pos_y), g.TempBuffer, text_end, false);
+                        RenderText(ImVec2(x1, text_pos_y), labels.Text(label_idx), labels.TextEnd(label_idx), false);
+                    }
+                    label_idx++;
+                }
+            };
+            if (log_y) {
+                const float range = log10f(y_max / y_min);
+                for (int e = decade_first; e <= decade_last; e++) {
+                    for (int i = 1; i < 10; ++i) {
+                        const float y_val = powf(10.0f, static_cast<float>(e)) * i;
+                        if (y_val < y_min) continue;
+                        if (y_val > y_max) break;
+                        draw_tick(log10f(y_val / y_min) / range, i > 1);
                     }
                 }
             }
+            else {
+                for (int i = 0; i <= axis_info_y.tick_count; ++i) {
+                    const float tick_pos = axis_info_y.tick_first + i * axis_info_y.tick_inc;
+                    if (tick_pos < 0.0f) continue;
+                    if (tick_pos > 1.0f) break;
+                    draw_tick(tick_pos, i % (conf.axis_y.tick_subs + 1) != 0);
+                }
+            }
         }
 
-        const float inv_scale = (conf.scale.min == conf.scale.max) ?
-            0.0f : (1.0f / (conf.scale.max - conf.scale.min));
+        IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_axes));
 
         const ImU32 col_hovered = GetColorU32(ImGuiCol_PlotLinesHovered);
         ImU32 col_base = GetColorU32(ImGuiCol_PlotLines);
 
         window->DrawList->PushClipRect(inner_bb.Min, inner_bb.Max, true);
         ImRect inner_bb_clipped = ImRect(window->DrawList->GetClipRectMin(), window->DrawList->GetClipRectMax());
-        for (int i = 0; i < ys_count; ++i) {
-            if (colors) {
-                if (colors[i]) col_base = colors[i];
-                else col_base = GetColorU32(ImGuiCol_PlotLines);
-            }
-            // Point in the normalized space of our target rectangle
-            ImVec2 tp0 = ImVec2(0.0f, 1.0f - (ys_list[i][0] - conf.scale.min) * inv_scale);
-
-            for (size_t n = 1; n < conf.values.count; n++)
-            {
-                const float t1 = lerp_inv(x_min, x_max, conf.values.xs.IsNullptr() ? n : conf.values.xs[n]);
-                const ImVec2 tp1 = ImVec2(
-                    rescale(t1, x_min, x_max, conf.scale.type),
-                    1.0f - (ys_list[i][n] - conf.scale.min) * inv_scale);
-
-                ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max, tp0);
-                ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max, tp1);
-
-                if (n == v_hovered) {
-                    window->DrawList->AddCircleFilled(pos1, 3, col_hovered);
-                }
-
+        const int columns = static_cast<int>(inner_bb.GetWidth());
+        // Reuse last frame's series geometry if nothing it depends on changed
+        GeometryCache* geometry = conf.generation ? &get_plot_state(id).geometry : nullptr;
+        const GeometryKey key = { conf.generation, inner_bb, x_min, x_max, y_min, y_max,
+            conf.scale.type, conf.scale.type_y, first, last, ys_count, conf.line_thickness, col_base,
+            colors ? ImHashData(colors, ys_count * sizeof(ImU32), 0) : 0,
+            conf.markers.shape, conf.markers.size, conf.markers.lines, conf.decimation, conf.skip_small_lines,
+            conf.lod.cache, conf.lod.submit != nullptr, conf.lod.memory_budget, conf.lod.summaries, conf.lod.summary_bucket };
+        if (geometry && geometry->valid && geometry->key == key) {
+            geometry->Replay(window->DrawList);
+        }
+        else {
+            ImDrawList* draw_list = window->DrawList;
+            const int cmd_count = draw_list->CmdBuffer.Size;
+            const int vtx_start = draw_list->VtxBuffer.Size;
+            const int idx_start = draw_list->IdxBuffer.Size;
+            const unsigned int vtx_base = draw_list->_VtxCurrentIdx;
 
-                if (!conf.skip_small_lines || ImLengthSqr(pos1 - pos0) > 1.0f * 1.0f) {
-                    if (inner_bb_clipped.Contains(pos0) || inner_bb_clipped.Contains(pos1)) {
-                        window->DrawList->AddLine(
-                            pos0,
-                            pos1,
-                            col_base,
-                            conf.line_thickness);
+            static PointBuffer decimated;
+            static ImVector<ImVec2> run;
+            static ImVector<ImVec2> marker_points;
+            static ImVector<ImU32> marker_taken;
+            static MarkerShape marker_shape;
+            const bool markers = conf.markers.shape != PlotConfig::Markers::Shape::None;
+            const bool lines = !markers || conf.markers.lines;
+            if (markers) {
+                make_marker(conf.markers.shape, conf.markers.size, marker_shape);
+            }
+            const float marker_r = conf.markers.size * 0.5f;
+            const bool parallel = conf.parallel.run && ys_count > 1 && visible > 1;
+            SeriesContext ctx = { &conf, ys_list, ys_count, nullptr, inner_bb, x_min, x_max, y_min, y_max, first, last, columns, parallel };
+            if (conf.lod.cache || conf.append_only || parallel) {
+                ctx.state = &get_plot_state(id);
+            }
+            if (parallel) {
+                prepare_series(ctx);
+                conf.parallel.run(build_series_task, ys_count, &ctx, conf.parallel.user_data);
+            }
+            bool complete = true;
+            for (int i = 0; i < ys_count && visible > 1; ++i) {
+                if (colors) {
+                    if (colors[i]) col_base = colors[i];
+                    else col_base = GetColorU32(ImGuiCol_PlotLines);
+                }
+                PolylineBuilder line = { window->DrawList, inner_bb_clipped, col_base, conf.line_thickness, &run, ImVec2(), false, 0, 0 };
+                MarkerBuilder marker = { window->DrawList, ImRect(inner_bb_clipped.Min - ImVec2(marker_r, marker_r),
+                    inner_bb_clipped.Max + ImVec2(marker_r, marker_r)), inner_bb.Min, columns + 1, static_cast<int>(inner_bb.GetHeight()) + 1,
+                    col_base, &marker_shape, &marker_points, &marker_taken, 0, 0, 0 };
+                if (markers) marker.Begin();
+                auto add = [&](const ImVec2& p) {
+                    if (lines) line.Add(p);
+                    if (markers) marker.Add(p);
+                };
+                SeriesStats series_stats;
+                if (parallel) {
+                    const SeriesPoints& series = ctx.state->Series(i);
+                    for (int n = 0; n < series.points.Size; n++) {
+                        add(series.points[n]);
                     }
-                    // discard last line's end point if we skipped due to clipping
-                    tp0 = tp1;
+                    complete &= series.complete;
+                    series_stats = series.stats;
+                }
+                else {
+                    complete &= build_series(ctx, i, decimated, series_stats, add);
+                }
+                line.Flush();
+                if (markers) marker.Flush();
+#ifndef IMGUI_PLOT_DISABLE_STATS
+                if (stats) {
+                    stats->samples_visited += series_stats.samples;
+                    stats->segments_skipped += series_stats.skipped;
+                    stats->segments_emitted += line.emitted;
+                    stats->segments_clipped += line.clipped + marker.clipped;
+                    stats->markers_emitted += marker.emitted;
+                    stats->markers_merged += marker.merged;
                 }
+#endif
+            }
+
+            // placeholders must not outlive the pyramids they stand in for
+            if (geometry) {
+                geometry->key = key;
+                geometry->Capture(draw_list, cmd_count, vtx_start, idx_start, vtx_base);
+                geometry->valid &= complete;
+            }
+        }
+
+        if (v_hovered >= 0) {
+            for (int i = 0; i < ys_count; ++i) {
+                const SeriesMapper map = make_mapper(conf, ys_list[i], inner_bb, x_min, x_max, y_min, y_max);
+                window->DrawList->AddCircleFilled(map(v_hovered), 3, col_hovered);
             }
         }
         window->DrawList->PopClipRect();
+        IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_series));
 
         if (conf.v_lines.show) {
             for (size_t i = 0; i < conf.v_lines.count; ++i) {
@@ -372,13 +2355,15 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
             }
         }
 
+        IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_axes));
+
         if (conf.selection.show) {
             if (hovered) {
                 if (g.IO.MouseClicked[0]) {
                     SetActiveID(id, window);
                     FocusWindow(window);
 
-                    const size_t v_idx = cursor_to_idx(g.IO.MousePos, inner_bb, conf, x_min, x_max);
+                    const size_t v_idx = cursor_idx();
                     size_t start = v_idx;
                     size_t end = start;
                     if (conf.selection.sanitize_fn)
@@ -393,7 +2378,7 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
 
             if (g.ActiveId == id) {
                 if (g.IO.MouseDown[0]) {
-                    const size_t v_idx = cursor_to_idx(g.IO.MousePos, inner_bb, conf, x_min, x_max);
+                    const size_t v_idx = cursor_idx();
                     const size_t start = *conf.selection.start;
                     size_t end = v_idx;
                     if (end > start) {
@@ -409,29 +2394,155 @@ PlotStatus Plot(const char* label, const PlotConfig& conf) {
                     ClearActiveID();
                 }
             }
-            float x_start;
-            float x_end;
-            if (conf.values.xs.IsNullptr()) {
-                x_start = static_cast<float>(*conf.selection.start);
-                x_end = static_cast<float>(*conf.selection.start + *conf.selection.length);
+            const float x_start = sample_x(conf.values, *conf.selection.start);
+            const float x_end = sample_x(conf.values, *conf.selection.start + *conf.selection.length);
+            // there's no clip rect here, so only draw the part that is in view
+            const float t0 = lerp_inv(x_min, x_max, x_start);
+            const float t1 = lerp_inv(x_min, x_max, x_end);
+            if (ImMax(t0, t1) >= 0.0f && ImMin(t0, t1) <= 1.0f) {
+                ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max,
+                    ImVec2(rescale(ImSaturate(t0), x_min, x_max, conf.scale.type), 0.f));
+                ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max,
+                    ImVec2(rescale(ImSaturate(t1), x_min, x_max, conf.scale.type), 1.f));
+                window->DrawList->AddRectFilled(pos0, pos1, IM_COL32(128, 128, 128, 32));
+                window->DrawList->AddRect(pos0, pos1, IM_COL32(128, 128, 128, 128));
             }
-            else {
-                x_start = conf.values.xs[*conf.selection.start];
-                x_end = conf.values.xs[*conf.selection.start + *conf.selection.length];
-            }
-            ImVec2 pos0 = ImLerp(inner_bb.Min, inner_bb.Max,
-                ImVec2(rescale(lerp_inv(x_min, x_max, x_start), x_min, x_max, conf.scale.type), 0.f));
-            ImVec2 pos1 = ImLerp(inner_bb.Min, inner_bb.Max,
-                ImVec2(rescale(lerp_inv(x_min, x_max, x_end), x_min, x_max, conf.scale.type), 1.f));
-            window->DrawList->AddRectFilled(pos0, pos1, IM_COL32(128, 128, 128, 32));
-            window->DrawList->AddRect(pos0, pos1, IM_COL32(128, 128, 128, 128));
         }
     }
 
+    IMGUI_PLOT_STAT(if (stats) watch.Lap(&stats->time_interaction));
+
     // Text overlay
     if (conf.overlay_text)
         RenderTextClipped(ImVec2(overlay_bb.Min.x, overlay_bb.Min.y), overlay_bb.Max, conf.overlay_text, NULL, NULL, ImVec2(0.5f,0.0f));
 
     return status;
 }
+
+#ifndef IMGUI_PLOT_DISABLE_STATS
+// Stats of the plots of the current and of the last frame, for ShowPlotStatsWindow()
+struct PlotStatsEntry {
+    char label[64];
+    PlotStats stats;
+};
+static ImVector<PlotStatsEntry> stats_frames[2];
+static int stats_frame = -1; // frame of stats_frames[0]
+static int stats_window_frame = -2; // last frame ShowPlotStatsWindow() was called in
+
+static void stats_record(ImGuiID id, const char* label, const PlotStats& stats) {
+    ImGuiContext& g = *GImGui;
+    if (stats_frame != g.FrameCount) {
+        stats_frames[1].swap(stats_frames[0]);
+        if (stats_frame != g.FrameCount - 1) stats_frames[1].resize(0);
+        stats_frames[0].resize(0);
+        stats_frame = g.FrameCount;
+    }
+    PlotStatsEntry entry;
+    ImStrncpy(entry.label, label, IM_ARRAYSIZE(entry.label));
+    entry.stats = stats;
+    stats_frames[0].push_back(entry);
+
+    PlotState& state = get_plot_state(id);
+    state.stats = stats;
+    state.has_stats = true;
+}
+#endif
+
+PlotStatus Plot(const char* label, const PlotConfig& conf) {
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    // all plots are measured while the stats window is open
+    ImGuiContext& g = *GImGui;
+    PlotStats collected;
+    PlotStats* stats = conf.stats ? conf.stats : (g.FrameCount - stats_window_frame <= 1 ? &collected : nullptr);
+    if (!stats) {
+        return plot_impl(label, conf, nullptr);
+    }
+    *stats = PlotStats();
+    ImGuiWindow* window = GetCurrentWindow();
+    const int vtx_start = window->DrawList->VtxBuffer.Size;
+    const int idx_start = window->DrawList->IdxBuffer.Size;
+    const StatClock::time_point start = StatClock::now();
+    const PlotStatus status = plot_impl(label, conf, stats);
+    stats->time_total = std::chrono::duration<double>(StatClock::now() - start).count();
+    stats->vertices = window->DrawList->VtxBuffer.Size - vtx_start;
+    stats->indices = window->DrawList->IdxBuffer.Size - idx_start;
+    if (!window->SkipItems) {
+        stats_record(window->GetID(label), label, *stats);
+    }
+    return status;
+#else
+    return plot_impl(label, conf, nullptr);
+#endif
+}
+
+bool PlotGetStats(ImGuiID id, PlotStats* out) {
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    PlotState* state = find_plot_state(id);
+    if (!state || !state->has_stats) return false;
+    *out = state->stats;
+    return true;
+#else
+    IM_UNUSED(id);
+    IM_UNUSED(out);
+    return false;
+#endif
+}
+
+void ShowPlotStatsWindow(bool* p_open) {
+    if (!Begin("Plot stats", p_open)) {
+        End();
+        return;
+    }
+#ifndef IMGUI_PLOT_DISABLE_STATS
+    ImGuiContext& g = *GImGui;
+    stats_window_frame = g.FrameCount;
+    // plots after this window haven't been drawn yet, so show the last frame
+    const ImVector<PlotStatsEntry>* frame = stats_frame == g.FrameCount ? &stats_frames[1] :
+        stats_frame == g.FrameCount - 1 ? &stats_frames[0] : nullptr;
+    static ImVector<const PlotStatsEntry*> sorted;
+    sorted.resize(0);
+    double total = 0;
+    for (int i = 0; frame && i < frame->Size; i++) {
+        sorted.push_back(&(*frame)[i]);
+        total += (*frame)[i].stats.time_total;
+    }
+    ImQsort(sorted.Data, static_cast<size_t>(sorted.Size), sizeof(sorted[0]), [](const void* a, const void* b) {
+        const double ta = (*static_cast<const PlotStatsEntry* const*>(a))->stats.time_total;
+        const double tb = (*static_cast<const PlotStatsEntry* const*>(b))->stats.time_total;
+        return ta < tb ? 1 : ta > tb ? -1 : 0;
+    });
+    Text("%d plots, %.3f ms", sorted.Size, total * 1e3);
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Resizable;
+    if (BeginTable("plots", 9, flags)) {
+        TableSetupScrollFreeze(0, 1);
+        TableSetupColumn("Plot");
+        TableSetupColumn("Total ms");
+        TableSetupColumn("Axes ms");
+        TableSetupColumn("Series ms");
+        TableSetupColumn("Input ms");
+        TableSetupColumn("Samples");
+        TableSetupColumn("Segments");
+        TableSetupColumn("Skipped/clipped");
+        TableSetupColumn("Vertices");
+        TableHeadersRow();
+        for (int i = 0; i < sorted.Size; i++) {
+            const PlotStats& s = sorted[i]->stats;
+            TableNextRow();
+            TableNextColumn(); TextUnformatted(sorted[i]->label);
+            TableNextColumn(); Text("%.3f", s.time_total * 1e3);
+            TableNextColumn(); Text("%.3f", s.time_axes * 1e3);
+            TableNextColumn(); Text("%.3f", s.time_series * 1e3);
+            TableNextColumn(); Text("%.3f", s.time_interaction * 1e3);
+            TableNextColumn(); Text("%zu", s.samples_visited);
+            TableNextColumn(); Text("%zu", s.segments_emitted);
+            TableNextColumn(); Text("%zu/%zu", s.segments_skipped, s.segments_clipped);
+            TableNextColumn(); Text("%d", s.vertices);
+        }
+        EndTable();
+    }
+#else
+    TextUnformatted("Plot stats were compiled out with IMGUI_PLOT_DISABLE_STATS.");
+#endif
+    End();
+}
 }
@@ -0,0 +1,273 @@
+#include <imgui_plot_file.h>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cfloat>
+#include <cstdio>
+#include <cstring>
+
+#if defined(_WIN32)
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ImGui {
+// Layout of the "<path>.minmax" sidecar, followed by the summary of every
+// channel, channel after channel
+struct SidecarHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t type;
+    uint64_t file_size;
+    uint64_t file_time; // modification time of the capture, see map_file()
+    uint64_t header;
+    uint64_t channels;
+    uint64_t bucket;
+    uint64_t entries; // per channel
+};
+
+static const char sidecar_magic[8] = { 'I', 'M', 'P', 'L', 'O', 'T', 'M', 'M' };
+static const uint32_t sidecar_version = 2;
+
+// Maps a whole file read-only, the pages are loaded on first access
+static bool map_file(const char* path, const unsigned char** data, size_t* size, uint64_t* time) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+    LARGE_INTEGER file_size;
+    FILETIME file_time;
+    bool ok = GetFileSizeEx(file, &file_size) && file_size.QuadPart > 0 && GetFileTime(file, nullptr, nullptr, &file_time);
+    if (ok) {
+        HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        const void* view = mapping ? MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0) : nullptr;
+        // the view keeps the mapping alive
+        if (mapping) CloseHandle(mapping);
+        ok = view != nullptr;
+        if (ok) {
+            *data = static_cast<const unsigned char*>(view);
+            *size = static_cast<size_t>(file_size.QuadPart);
+            *time = (static_cast<uint64_t>(file_time.dwHighDateTime) << 32) | file_time.dwLowDateTime;
+        }
+    }
+    CloseHandle(file);
+    return ok;
+#else
+    const int fd = open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    bool ok = fstat(fd, &st) == 0 && st.st_size > 0;
+    if (ok) {
+        void* view = mmap(nullptr, static_cast<size_t>(st.st_size), PROT_READ, MAP_SHARED, fd, 0);
+        ok = view != MAP_FAILED;
+        if (ok) {
+            *data = static_cast<const unsigned char*>(view);
+            *size = static_cast<size_t>(st.st_size);
+            // in nanoseconds, a capture rewritten within the same second
+            // must not pass for the old one
+#if defined(__APPLE__)
+            const struct timespec& mtime = st.st_mtimespec;
+#else
+            const struct timespec& mtime = st.st_mtim;
+#endif
+            *time = static_cast<uint64_t>(mtime.tv_sec) * 1000000000u + static_cast<uint64_t>(mtime.tv_nsec);
+        }
+    }
+    close(fd);
+    return ok;
+#endif
+}
+
+static void unmap_file(const unsigned char* data, size_t size) {
+    if (!data) return;
+#if defined(_WIN32)
+    IM_UNUSED(size);
+    UnmapViewOfFile(data);
+#else
+    munmap(const_cast<unsigned char*>(data), size);
+#endif
+}
+
+// Tells the OS how the mapped pages are going to be read
+static void advise_sequential(const unsigned char* data, size_t size, bool sequential) {
+#if defined(MADV_SEQUENTIAL) && defined(MADV_RANDOM)
+    madvise(const_cast<unsigned char*>(data), size, sequential ? MADV_SEQUENTIAL : MADV_RANDOM);
+#else
+    IM_UNUSED(data);
+    IM_UNUSED(size);
+    IM_UNUSED(sequential);
+#endif
+}
+
+static size_t type_size(PlotConfig::Buffer::Type type) {
+    switch (type) {
+    case PlotConfig::Buffer::Type::float32: return sizeof(float);
+    case PlotConfig::Buffer::Type::float64: return sizeof(double);
+    case PlotConfig::Buffer::Type::int32: return sizeof(int32_t);
+    case PlotConfig::Buffer::Type::int16: return sizeof(int16_t);
+    case PlotConfig::Buffer::Type::uint16: return sizeof(uint16_t);
+    case PlotConfig::Buffer::Type::uint8: return sizeof(uint8_t);
+    case PlotConfig::Buffer::Type::int64: return sizeof(int64_t);
+    case PlotConfig::Buffer::Type::uint32: return sizeof(uint32_t);
+    }
+    return 0;
+}
+
+// Min/max of every bucket of every channel, in one pass over the samples
+template<typename T> static void summarize(const unsigned char* samples, size_t count, size_t channels, size_t entries, ImVec2* out) {
+    const T* s = reinterpret_cast<const T*>(samples);
+    for (size_t e = 0; e < entries; e++) {
+        for (size_t c = 0; c < channels; c++) {
+            out[c * entries + e] = ImVec2(FLT_MAX, -FLT_MAX);
+        }
+        const size_t end = ImMin((e + 1) * PlotFile::summary_bucket, count);
+        for (size_t i = e * PlotFile::summary_bucket; i < end; i++) {
+            for (size_t c = 0; c < channels; c++) {
+                const float v = static_cast<float>(s[i * channels + c]);
+                ImVec2& m = out[c * entries + e];
+                if (v < m.x) m.x = v;
+                if (v > m.y) m.y = v;
+            }
+        }
+    }
+}
+
+bool PlotFile::Open(const char* path, PlotConfig::Buffer::Type _type, size_t _header, size_t _channels) {
+    Close();
+    uint64_t file_time = 0;
+    if (_channels == 0 || !map_file(path, &file.data, &file.size, &file_time)) {
+        return false;
+    }
+    const size_t sample_size = type_size(_type) * _channels;
+    // the samples are read in place, so they must be aligned to their type
+    if (_header % type_size(_type) != 0 || file.size <= _header || (file.size - _header) / sample_size == 0) {
+        Close();
+        return false;
+    }
+    type = _type;
+    header = _header;
+    channels = _channels;
+    count = (file.size - header) / sample_size;
+
+    ImVector<char> sidecar_path;
+    sidecar_path.resize(static_cast<int>(strlen(path)));
+    memcpy(sidecar_path.Data, path, sidecar_path.Size);
+    for (const char* c = ".minmax"; *c; c++) sidecar_path.push_back(*c);
+    sidecar_path.push_back('\0');
+    if (!LoadSummary(sidecar_path.Data, file_time)) {
+        BuildSummary(sidecar_path.Data, file_time);
+    }
+    return true;
+}
+
+void PlotFile::Close() {
+    unmap_file(file.data, file.size);
+    unmap_file(sidecar.data, sidecar.size);
+    file = Mapping();
+    sidecar = Mapping();
+    summary_built.clear();
+    summary = nullptr;
+    count = 0;
+    channels = 0;
+}
+
+PlotConfig::Buffer PlotFile::Channel(size_t channel) const {
+    if (!IsOpen()) return PlotConfig::Buffer();
+    const size_t size = type_size(type);
+    return PlotConfig::Buffer(file.data + header, type, channel * size, channels > 1 ? channels * size : 0);
+}
+
+const ImVec2* PlotFile::Summary(size_t channel) const {
+    const size_t entries = (count + summary_bucket - 1) / summary_bucket;
+    return summary ? summary + channel * entries : nullptr;
+}
+
+// Uses the sidecar if it was made for the file as it is now
+bool PlotFile::LoadSummary(const char* path, uint64_t file_time) {
+    uint64_t time = 0;
+    if (!map_file(path, &sidecar.data, &sidecar.size, &time)) {
+        return false;
+    }
+    const size_t entries = (count + summary_bucket - 1) / summary_bucket;
+    SidecarHeader h;
+    bool ok = sidecar.size == sizeof(h) + channels * entries * sizeof(ImVec2);
+    if (ok) {
+        memcpy(&h, sidecar.data, sizeof(h));
+        ok = memcmp(h.magic, sidecar_magic, sizeof(h.magic)) == 0 && h.version == sidecar_version &&
+            h.type == static_cast<uint32_t>(type) && h.file_size == file.size && h.file_time == file_time &&
+            h.header == header && h.channels == channels && h.bucket == summary_bucket && h.entries == entries;
+    }
+    if (!ok) {
+        unmap_file(sidecar.data, sidecar.size);
+        sidecar = Mapping();
+        return false;
+    }
+    summary = reinterpret_cast<const ImVec2*>(sidecar.data + sizeof(h));
+    return true;
+}
+
+// Reads the whole capture once and stores the summary next to it. If that
+// fails, the summary is kept in memory for as long as the file is open.
+void PlotFile::BuildSummary(const char* path, uint64_t file_time) {
+    const size_t entries = (count + summary_bucket - 1) / summary_bucket;
+    summary_built.resize(static_cast<int>(channels * entries));
+    const unsigned char* samples = file.data + header;
+    advise_sequential(file.data, file.size, true);
+    switch (type) {
+    case PlotConfig::Buffer::Type::float32: summarize<float>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::float64: summarize<double>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::int32: summarize<int32_t>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::int16: summarize<int16_t>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::uint16: summarize<uint16_t>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::uint8: summarize<uint8_t>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::int64: summarize<int64_t>(samples, count, channels, entries, summary_built.Data); break;
+    case PlotConfig::Buffer::Type::uint32: summarize<uint32_t>(samples, count, channels, entries, summary_built.Data); break;
+    }
+    // plots only read the pages in view from now on
+    advise_sequential(file.data, file.size, false);
+    summary = summary_built.Data;
+
+    SidecarHeader h;
+    memset(&h, 0, sizeof(h));
+    memcpy(h.magic, sidecar_magic, sizeof(h.magic));
+    h.version = sidecar_version;
+    h.type = static_cast<uint32_t>(type);
+    h.file_size = file.size;
+    h.file_time = file_time;
+    h.header = header;
+    h.channels = channels;
+    h.bucket = summary_bucket;
+    h.entries = entries;
+
+    // write to a temporary file first, so that no reader sees half a sidecar
+    ImVector<char> tmp_path;
+    tmp_path.resize(static_cast<int>(strlen(path)));
+    memcpy(tmp_path.Data, path, tmp_path.Size);
+    for (const char* c = ".tmp"; *c; c++) tmp_path.push_back(*c);
+    tmp_path.push_back('\0');
+    FILE* f = fopen(tmp_path.Data, "wb");
+    if (!f) return;
+    bool ok = fwrite(&h, sizeof(h), 1, f) == 1 &&
+        fwrite(summary_built.Data, sizeof(ImVec2), summary_built.Size, f) == static_cast<size_t>(summary_built.Size);
+    ok = fclose(f) == 0 && ok;
+#if defined(_WIN32)
+    // rename() doesn't replace existing files there
+    if (ok) remove(path);
+#endif
+    if (!ok || rename(tmp_path.Data, path) != 0) {
+        remove(tmp_path.Data);
+        return;
+    }
+    // switch to the mapped sidecar, the pages are shared with the OS cache
+    uint64_t time = 0;
+    if (map_file(path, &sidecar.data, &sidecar.size, &time)) {
+        summary = reinterpret_cast<const ImVec2*>(sidecar.data + sizeof(h));
+        summary_built.clear();
+    }
+}
+}
@@ -0,0 +1,154 @@
+#include <imgui_plot_waterfall.h>
+#include <imgui.h>
+#include <imgui_internal.h>
+#include <cstring>
+
+namespace ImGui {
+static const ImU32 colormap_grayscale[] = {
+    IM_COL32(0, 0, 0, 255), IM_COL32(255, 255, 255, 255),
+};
+static const ImU32 colormap_viridis[] = {
+    IM_COL32(68, 1, 84, 255), IM_COL32(72, 40, 120, 255), IM_COL32(62, 74, 137, 255), IM_COL32(49, 104, 142, 255),
+    IM_COL32(38, 130, 142, 255), IM_COL32(31, 158, 137, 255), IM_COL32(53, 183, 121, 255), IM_COL32(109, 205, 89, 255),
+    IM_COL32(180, 222, 44, 255), IM_COL32(253, 231, 37, 255),
+};
+static const ImU32 colormap_magma[] = {
+    IM_COL32(0, 0, 4, 255), IM_COL32(24, 15, 61, 255), IM_COL32(68, 15, 118, 255), IM_COL32(114, 31, 129, 255),
+    IM_COL32(158, 47, 127, 255), IM_COL32(205, 64, 113, 255), IM_COL32(241, 96, 93, 255), IM_COL32(253, 150, 104, 255),
+    IM_COL32(254, 201, 141, 255), IM_COL32(252, 253, 191, 255),
+};
+static const ImU32 colormap_jet[] = {
+    IM_COL32(0, 0, 127, 255), IM_COL32(0, 0, 255, 255), IM_COL32(0, 127, 255, 255), IM_COL32(0, 255, 255, 255),
+    IM_COL32(127, 255, 127, 255), IM_COL32(255, 255, 0, 255), IM_COL32(255, 127, 0, 255), IM_COL32(255, 0, 0, 255),
+    IM_COL32(127, 0, 0, 255),
+};
+
+static ImU32 lerp_color(ImU32 a, ImU32 b, float t) {
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8) {
+        const float ca = static_cast<float>((a >> shift) & 0xFF);
+        const float cb = static_cast<float>((b >> shift) & 0xFF);
+        out |= static_cast<ImU32>(ca + (cb - ca) * t + 0.5f) << shift;
+    }
+    return out;
+}
+
+PlotWaterfall::PlotWaterfall() {
+    SetColormap(Colormap::Viridis);
+}
+
+void PlotWaterfall::Init(int _width, int _rows) {
+    IM_ASSERT(_width > 0 && _rows > 0);
+    width = _width;
+    rows = _rows;
+    values.resize(width * rows);
+    pixels.resize(width * rows);
+    Clear();
+}
+
+void PlotWaterfall::Clear() {
+    for (int i = 0; i < values.Size; i++) values[i] = min;
+    for (int i = 0; i < pixels.Size; i++) pixels[i] = lut[0];
+    head = 0;
+    dirty_rows = 0;
+    dirty_all = true;
+}
+
+void PlotWaterfall::SetRange(float _min, float _max) {
+    if (_min == min && _max == max) return;
+    min = _min;
+    max = _max;
+    lut_scale = max > min ? (lut_size - 1) / (max - min) : 0.0f;
+    for (int row = 0; row < rows; row++) ConvertRow(row);
+    dirty_all = true;
+}
+
+void PlotWaterfall::SetColormap(Colormap colormap) {
+    switch (colormap) {
+    case Colormap::Grayscale: SetColormap(colormap_grayscale, IM_ARRAYSIZE(colormap_grayscale)); break;
+    case Colormap::Viridis: SetColormap(colormap_viridis, IM_ARRAYSIZE(colormap_viridis)); break;
+    case Colormap::Magma: SetColormap(colormap_magma, IM_ARRAYSIZE(colormap_magma)); break;
+    case Colormap::Jet: SetColormap(colormap_jet, IM_ARRAYSIZE(colormap_jet)); break;
+    }
+}
+
+void PlotWaterfall::SetColormap(const ImU32* colors, int count) {
+    IM_ASSERT(count > 0);
+    for (int i = 0; i < lut_size; i++) {
+        const float t = static_cast<float>(i) * (count - 1) / (lut_size - 1);
+        const int k = ImMin(static_cast<int>(t), count - 1);
+        lut[i] = k + 1 < count ? lerp_color(colors[k], colors[k + 1], t - k) : colors[k];
+    }
+    for (int row = 0; row < rows; row++) ConvertRow(row);
+    dirty_all = true;
+}
+
+void PlotWaterfall::PushRow(const float* row_values) {
+    if (rows == 0) return;
+    // rows are added upwards, so that the image reads newest to oldest
+    // from head on
+    head = (head + rows - 1) % rows;
+    memcpy(values.Data + head * width, row_values, width * sizeof(float));
+    ConvertRow(head);
+    dirty_rows = ImMin(dirty_rows + 1, rows);
+}
+
+void PlotWaterfall::ConvertRow(int row) {
+    const float* v = values.Data + row * width;
+    ImU32* out = pixels.Data + row * width;
+    for (int i = 0; i < width; i++) {
+        float t = (v[i] - min) * lut_scale;
+        // also catches NaN
+        if (!(t > 0.0f)) t = 0.0f;
+        if (t > lut_size - 1) t = lut_size - 1;
+        out[i] = lut[static_cast<int>(t + 0.5f)];
+    }
+}
+
+void PlotWaterfall::UpdateTexture() {
+    if (!update_texture || rows == 0) return;
+    if (texture == ImTextureID() || texture_width != width || texture_height != rows) {
+        dirty_all = true;
+    }
+    if (dirty_all) {
+        update_texture(&texture, width, rows, pixels.Data, 0, rows, user_data);
+    }
+    else if (dirty_rows > 0) {
+        // the new rows start at head and may wrap around the last one
+        const int count = ImMin(dirty_rows, rows - head);
+        update_texture(&texture, width, rows, pixels.Data + head * width, head, count, user_data);
+        if (dirty_rows > count) {
+            update_texture(&texture, width, rows, pixels.Data, 0, dirty_rows - count, user_data);
+        }
+    }
+    texture_width = width;
+    texture_height = rows;
+    dirty_rows = 0;
+    dirty_all = false;
+}
+
+void PlotWaterfall::Draw(const char* label, const ImVec2& size) {
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return;
+
+    const ImGuiStyle& style = GImGui->Style;
+    const ImRect frame_bb(
+        window->DC.CursorPos,
+        window->DC.CursorPos + ImVec2(
+            size.x < 0 ? window->WorkRect.GetSize().x : size.x,
+            size.y < 0 ? window->WorkRect.GetSize().y : size.y > 0 ? size.y : static_cast<float>(rows)));
+    ItemSize(frame_bb, style.FramePadding.y);
+    if (!ItemAdd(frame_bb, window->GetID(label)))
+        return;
+
+    UpdateTexture();
+    if (texture == ImTextureID()) {
+        RenderFrame(frame_bb.Min, frame_bb.Max, GetColorU32(ImGuiCol_FrameBg), true, style.FrameRounding);
+        return;
+    }
+    // the newest row is at the top, the texture repeats below the oldest one
+    const float v0 = static_cast<float>(head) / rows;
+    window->DrawList->AddImage(texture, frame_bb.Min, frame_bb.Max, ImVec2(0.0f, v0), ImVec2(1.0f, v0 + 1.0f));
+}
+}
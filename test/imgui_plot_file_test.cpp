@@ -0,0 +1,126 @@
+// Opens generated captures with PlotFile and checks the samples, the
+// summaries and when the "<path>.minmax" sidecar is used. The files are
+// written to the working directory. Returns 1 on any mismatch.
+
+#include <imgui_plot_file.h>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <thread>
+#include <vector>
+
+using namespace ImGui;
+
+static const char* capture_path = "imgui_plot_file_test.raw";
+static const char* sidecar_path = "imgui_plot_file_test.raw.minmax";
+static const size_t header = 64;
+static const size_t channels = 2;
+static const size_t count = 3 * PlotFile::summary_bucket + 100; // the last summary entry is partial
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (ok) return;
+    failures++;
+    printf("failed: %s\n", what);
+}
+
+static int16_t sample(size_t i, size_t channel, int seed) {
+    return static_cast<int16_t>(channel == 0 ? (i * 7919 + seed) % 2000 - 1000 : seed - static_cast<int>(i % 300));
+}
+
+static void write_capture(int seed) {
+    std::vector<unsigned char> data(header, 0xAB);
+    for (size_t i = 0; i < count; i++) {
+        for (size_t c = 0; c < channels; c++) {
+            const int16_t v = sample(i, c, seed);
+            const unsigned char* bytes = reinterpret_cast<const unsigned char*>(&v);
+            data.insert(data.end(), bytes, bytes + sizeof(v));
+        }
+    }
+    FILE* f = fopen(capture_path, "wb");
+    check(f && fwrite(data.data(), 1, data.size(), f) == data.size() && fclose(f) == 0, "write capture");
+}
+
+// Samples and summaries against the generated values
+static void check_contents(const PlotFile& file, int seed) {
+    check(file.Count() == count, "Count()");
+    check(file.Channels() == channels, "Channels()");
+    const size_t entries = (count + PlotFile::summary_bucket - 1) / PlotFile::summary_bucket;
+    for (size_t c = 0; c < channels; c++) {
+        const PlotConfig::Buffer buf = file.Channel(c);
+        bool samples_ok = true;
+        for (size_t i = 0; i < count; i++) {
+            samples_ok &= buf[i] == sample(i, c, seed);
+        }
+        check(samples_ok, "Channel() samples");
+
+        const ImVec2* summary = file.Summary(c);
+        bool summary_ok = summary != nullptr;
+        for (size_t e = 0; summary && e < entries; e++) {
+            float lo = sample(e * PlotFile::summary_bucket, c, seed), hi = lo;
+            for (size_t i = e * PlotFile::summary_bucket; i < count && i < (e + 1) * PlotFile::summary_bucket; i++) {
+                const float v = sample(i, c, seed);
+                lo = v < lo ? v : lo;
+                hi = v > hi ? v : hi;
+            }
+            summary_ok &= summary[e].x == lo && summary[e].y == hi;
+        }
+        check(summary_ok, "Summary() against brute force");
+    }
+}
+
+// Overwrites the first summary entry of the sidecar with a marker, a
+// mapped sidecar shows it and a rebuilt one doesn't
+static const ImVec2 marker(-12345.0f, 12345.0f);
+
+static void mark_sidecar() {
+    FILE* f = fopen(sidecar_path, "r+b");
+    check(f != nullptr, "sidecar written");
+    if (!f) return;
+    const size_t entries = (count + PlotFile::summary_bucket - 1) / PlotFile::summary_bucket;
+    fseek(f, 0, SEEK_END);
+    const long summaries_start = ftell(f) - static_cast<long>(channels * entries * sizeof(ImVec2));
+    fseek(f, summaries_start, SEEK_SET);
+    check(fwrite(&marker, sizeof(marker), 1, f) == 1 && fclose(f) == 0, "mark sidecar");
+}
+
+static bool marked(const PlotFile& file) {
+    const ImVec2* summary = file.Summary(0);
+    return summary && summary[0].x == marker.x && summary[0].y == marker.y;
+}
+
+int main() {
+    remove(sidecar_path);
+    write_capture(1);
+    {
+        PlotFile file;
+        check(file.Open(capture_path, PlotConfig::Buffer::Type::int16, header, channels), "Open()");
+        check_contents(file, 1);
+    }
+    mark_sidecar();
+    {
+        PlotFile file;
+        check(file.Open(capture_path, PlotConfig::Buffer::Type::int16, header, channels), "Open() again");
+        check(marked(file), "sidecar mapped on reopen");
+    }
+    // same size and within the same second, but file times can be as
+    // coarse as a scheduler tick
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    write_capture(2);
+    {
+        PlotFile file;
+        check(file.Open(capture_path, PlotConfig::Buffer::Type::int16, header, channels), "Open() rewritten");
+        check(!marked(file), "sidecar rejected after rewrite");
+        check_contents(file, 2);
+    }
+    {
+        PlotFile file;
+        check(!file.Open(capture_path, PlotConfig::Buffer::Type::int16, header - 1, channels), "Open() with misaligned header");
+        check(!file.IsOpen() && file.Channel(0).raw == nullptr, "closed after failed Open()");
+    }
+    remove(capture_path);
+    remove(sidecar_path);
+    printf(failures ? "%d failures\n" : "PlotFile tests passed\n", failures);
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,134 @@
+// Compares the vectorized sample kernels with the scalar ones and checks
+// the precision of Log10 mapping. Includes the implementation to reach its
+// internal functions, so it's linked against Dear ImGui instead of the
+// imgui_plot library. Returns 1 on any mismatch.
+
+#include "../src/imgui_plot.cpp"
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+using namespace ImGui;
+
+typedef PlotConfig::Scale::Type ScaleType;
+
+static int failures = 0;
+
+// A narrow range of large values on a Log10 x-axis must still map every
+// sample close to where double precision puts it, not in steps of many
+// pixels
+static void test_log_range(const char* name, MapFn map) {
+    const float min = 1e6f, max = 1e6f + 100.0f, width = 1000.0f;
+    ScreenTransform tf;
+    tf.bb = ImRect(ImVec2(0.0f, 0.0f), ImVec2(width, 100.0f));
+    axis_transform(ScaleType::Log10, min, max, width, &tf.x_min, &tf.x_inv_min, &tf.kx);
+    axis_transform(ScaleType::Linear, 0.0f, 1.0f, 100.0f, &tf.y_min, &tf.y_inv_min, &tf.ky);
+    // every float in the range, 1/16 apart
+    std::vector<float> xs, ys;
+    for (float x = min; x <= max; x = nextafterf(x, 2.0f * max)) {
+        xs.push_back(x);
+        ys.push_back(0.5f);
+    }
+    std::vector<ImVec2> out(xs.size());
+    map(tf, xs.data(), ys.data(), xs.size(), out.data());
+    int distinct = 0;
+    double worst = 0.0;
+    for (size_t i = 0; i < xs.size(); i++) {
+        const double expected = log10(static_cast<double>(xs[i]) / min) / log10(static_cast<double>(max) / min) * width;
+        worst = ImMax(worst, fabs(out[i].x - expected));
+        if (i == 0 || out[i].x != out[i - 1].x) distinct++;
+    }
+    // the sample / min ratios are floats around 1, about 1.2 px apart here
+    if (worst > 1.5 || distinct < static_cast<int>(xs.size()) / 3) {
+        if (failures++ < 20) {
+            printf("%s: %zu samples on %d positions, off by up to %g px\n", name, xs.size(), distinct, worst);
+        }
+    }
+}
+
+#ifdef IMGUI_PLOT_SIMD
+static bool same(float a, float b) {
+    if (a != a || b != b) return a != a && b != b;
+    if (a == b) return true;
+    // the vector division may round differently from the scalar one
+    return fabsf(a - b) <= 1e-4f * ImMax(1.0f, ImMax(fabsf(a), fabsf(b)));
+}
+
+static void check(bool ok, const char* what, size_t n, size_t i, float expected, float got) {
+    if (ok) return;
+    if (failures++ < 20) {
+        printf("%s: n=%zu i=%zu scalar=%g simd=%g\n", what, n, i, expected, got);
+    }
+}
+
+// Positive and negative values, zero, NaN and a wide range of magnitudes
+static float sample_value(size_t i) {
+    switch (i % 7) {
+    case 0: return 0.0f;
+    case 1: return -100.0f - static_cast<float>(i);
+    case 2: return NAN;
+    case 3: return 1e-20f * (i + 1);
+    case 4: return 1e20f / (i + 1);
+    default: return 0.5f + static_cast<float>(i) * 3.25f;
+    }
+}
+
+template<ScaleType SX, ScaleType SY> static void test_map(const char* name) {
+    ScreenTransform tf;
+    tf.bb = ImRect(ImVec2(10.0f, 20.0f), ImVec2(810.0f, 620.0f));
+    tf.x_min = -3.0f;
+    tf.y_min = 2.0f;
+    tf.x_inv_min = 0.125f;
+    tf.y_inv_min = 3.0f;
+    tf.kx = 7.5f;
+    tf.ky = 0.25f;
+    std::vector<float> xs(block_size), ys(block_size);
+    for (size_t i = 0; i < block_size; i++) {
+        xs[i] = sample_value(i);
+        ys[i] = sample_value(i * 3 + 1);
+    }
+    // every tail length, then a full block
+    for (size_t n = 0; n <= block_size; n = n < 40 ? n + 1 : block_size + (n == block_size)) {
+        std::vector<ImVec2> expected(n + 1), got(n + 1);
+        map_block<SX, SY>(tf, xs.data(), ys.data(), n, expected.data());
+        map_block_simd<SX, SY>(tf, xs.data(), ys.data(), n, got.data());
+        for (size_t i = 0; i < n; i++) {
+            check(same(expected[i].x, got[i].x), name, n, i, expected[i].x, got[i].x);
+            check(same(expected[i].y, got[i].y), name, n, i, expected[i].y, got[i].y);
+        }
+    }
+}
+
+template<typename T> static void test_load(const char* name, LoadFn simd) {
+    std::vector<T> data(block_size + 8);
+    for (size_t i = 0; i < data.size(); i++) {
+        data[i] = static_cast<T>(i % 2 ? -static_cast<double>(i) * 1234567.0 : static_cast<double>(i) * 0.75);
+    }
+    const PlotConfig::Buffer buf(data.data());
+    for (size_t first = 0; first < 4; first++) {
+        for (size_t n = 0; n <= block_size; n = n < 40 ? n + 1 : block_size + (n == block_size)) {
+            std::vector<float> expected(n + 1), got(n + 1);
+            load_block<T>(buf, first, n, expected.data());
+            simd(buf, first, n, got.data());
+            for (size_t i = 0; i < n; i++) {
+                check(expected[i] == got[i], name, n, first + i, expected[i], got[i]);
+            }
+        }
+    }
+}
+#endif
+
+int main() {
+    test_log_range("log10 range scalar", map_block<ScaleType::Log10, ScaleType::Linear>);
+#ifdef IMGUI_PLOT_SIMD
+    test_log_range("log10 range simd", map_block_simd<ScaleType::Log10, ScaleType::Linear>);
+    test_map<ScaleType::Linear, ScaleType::Linear>("map linear/linear");
+    test_map<ScaleType::Linear, ScaleType::Log10>("map linear/log10");
+    test_map<ScaleType::Log10, ScaleType::Linear>("map log10/linear");
+    test_map<ScaleType::Log10, ScaleType::Log10>("map log10/log10");
+    test_load<double>("load float64", load_block_float64_simd);
+    test_load<int32_t>("load int32", load_block_int32_simd);
+#endif
+    printf(failures ? "%d mismatches\n" : "sample kernels match\n", failures);
+    return failures ? 1 : 0;
+}
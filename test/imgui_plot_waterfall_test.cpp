@@ -0,0 +1,137 @@
+// Checks the CPU side of PlotWaterfall without an ImGui context: the ring
+// of rows, the colormap lookup and the rows passed to update_texture.
+// Returns 1 on any mismatch.
+
+#include <imgui_plot_waterfall.h>
+#include <cmath>
+#include <cstdio>
+#include <initializer_list>
+#include <vector>
+
+using namespace ImGui;
+
+static int failures = 0;
+
+static void check(bool ok, const char* what) {
+    if (ok) return;
+    failures++;
+    printf("failed: %s\n", what);
+}
+
+static const int width = 4;
+static const int rows = 3;
+
+// What update_texture was called with since the last Take()
+struct Uploads {
+    struct Call {
+        int row, row_count;
+        bool pixels_ok;
+    };
+    std::vector<Call> calls;
+
+    bool Take(std::initializer_list<Call> expected) {
+        bool ok = calls.size() == expected.size();
+        size_t i = 0;
+        for (const Call& e : expected) {
+            ok = ok && calls[i].row == e.row && calls[i].row_count == e.row_count && calls[i].pixels_ok;
+            i++;
+        }
+        calls.clear();
+        return ok;
+    }
+};
+
+static const PlotWaterfall* current = nullptr;
+static int texture_storage = 0;
+
+static void update_texture(ImTextureID* texture, int w, int h, const ImU32* pixels, int row, int row_count, void* user_data) {
+    Uploads* uploads = static_cast<Uploads*>(user_data);
+    // the pixels must be the rows passed, straight from the image
+    const bool pixels_ok = w == width && h == rows && pixels == current->Pixels() + row * width;
+    uploads->calls.push_back({ row, row_count, pixels_ok });
+    *texture = reinterpret_cast<ImTextureID>(&texture_storage);
+}
+
+static ImU32 pixel(const PlotWaterfall& w, int row, int column) {
+    return w.Pixels()[row * w.Width() + column];
+}
+
+static ImU32 gray(int v) {
+    return IM_COL32(v, v, v, 255);
+}
+
+static void push(PlotWaterfall& w, float value) {
+    float row[width];
+    for (int i = 0; i < width; i++) row[i] = value;
+    w.PushRow(row);
+}
+
+int main() {
+    PlotWaterfall waterfall;
+    current = &waterfall;
+    Uploads uploads;
+    waterfall.update_texture = update_texture;
+    waterfall.user_data = &uploads;
+    waterfall.Init(width, rows);
+    waterfall.SetColormap(PlotWaterfall::Colormap::Grayscale);
+    waterfall.SetRange(0.0f, 1.0f);
+
+    // newer rows go upwards in the ring, Head() is the newest
+    check(waterfall.Head() == 0, "Head() after Init()");
+    push(waterfall, 0.0f);
+    check(waterfall.Head() == 2, "Head() after one row");
+    push(waterfall, 1.0f);
+    check(waterfall.Head() == 1, "Head() after two rows");
+    push(waterfall, 0.5f);
+    check(waterfall.Head() == 0, "Head() after three rows");
+    check(pixel(waterfall, 0, 0) == gray(128) && pixel(waterfall, 1, 0) == gray(255) && pixel(waterfall, 2, 0) == gray(0),
+        "rows in ring order");
+    push(waterfall, NAN);
+    check(waterfall.Head() == 2, "Head() wraps around");
+    push(waterfall, 5.0f);
+    push(waterfall, -5.0f);
+    check(pixel(waterfall, 1, 0) == gray(255) && pixel(waterfall, 0, 0) == gray(0), "values clamped to the range");
+
+    // the stored values are converted again, 0 would be in the middle now
+    waterfall.SetRange(-5.0f, 5.0f);
+    check(pixel(waterfall, 1, 0) == gray(255) && pixel(waterfall, 0, 0) == gray(0), "SetRange() reconverts");
+    check(pixel(waterfall, 2, 3) == gray(0), "NaN maps to the first color");
+    const ImU32 red_blue[] = { IM_COL32(255, 0, 0, 255), IM_COL32(0, 0, 255, 255) };
+    waterfall.SetColormap(red_blue, 2);
+    check(pixel(waterfall, 1, 0) == red_blue[1] && pixel(waterfall, 0, 0) == red_blue[0], "SetColormap() reconverts");
+
+    // the first upload creates the texture from all rows
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 0, rows, true } }), "first upload is the whole image");
+    waterfall.UpdateTexture();
+    check(uploads.Take({}), "nothing to upload");
+
+    // head is 0 here, new rows start at the new head
+    push(waterfall, 1.0f);
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 2, 1, true } }), "one new row");
+    push(waterfall, 1.0f);
+    push(waterfall, 1.0f);
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 0, 2, true } }), "two new rows");
+    // head 0 -> 2 -> 1, rows 1 and 2 are new
+    push(waterfall, 1.0f);
+    push(waterfall, 1.0f);
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 1, 2, true } }), "two new rows at the end");
+    // head 1 -> 0 -> 2, the new rows are 2 and 0
+    push(waterfall, 1.0f);
+    push(waterfall, 1.0f);
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 2, 1, true }, { 0, 1, true } }), "new rows wrapping around");
+    // more rows than the ring holds upload every row once, head 2 -> 1
+    for (int i = 0; i < rows + 1; i++) push(waterfall, 1.0f);
+    waterfall.UpdateTexture();
+    check(waterfall.Head() == 1 && uploads.Take({ { 1, 2, true }, { 0, 1, true } }), "more rows than the ring");
+    waterfall.SetRange(0.0f, 2.0f);
+    waterfall.UpdateTexture();
+    check(uploads.Take({ { 0, rows, true } }), "SetRange() uploads the whole image");
+
+    printf(failures ? "%d failures\n" : "PlotWaterfall tests passed\n", failures);
+    return failures ? 1 : 0;
+}